@@ -0,0 +1,154 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationTracker.h"
+
+
+namespace SplitsMgr
+{
+	namespace AllocationTracker
+	{
+		// Counters are per thread so the frame and scope reports only see the allocations of the thread displaying the interface.
+		static thread_local Counters		thread_counters{};
+
+		static Counters						frame_start{};
+		static Counters						last_frame{};
+		static ScopeReports					frame_scopes{};
+		static ScopeReports					last_frame_scopes{};
+
+		void on_allocation( size_t _size )
+		{
+			++thread_counters.m_allocations;
+			thread_counters.m_bytes += _size;
+		}
+
+		Counters get_thread_counters()
+		{
+			return thread_counters;
+		}
+
+		void begin_frame()
+		{
+			frame_start = thread_counters;
+			frame_scopes.fill( ScopeReport{} );
+		}
+
+		void end_frame()
+		{
+			last_frame.m_allocations = thread_counters.m_allocations - frame_start.m_allocations;
+			last_frame.m_bytes = thread_counters.m_bytes - frame_start.m_bytes;
+			last_frame_scopes = frame_scopes;
+		}
+
+		const Counters& get_last_frame_counters()
+		{
+			return last_frame;
+		}
+
+		const ScopeReports& get_last_frame_scopes()
+		{
+			return last_frame_scopes;
+		}
+
+		Counters get_last_frame_scope( std::string_view _name )
+		{
+			for( const ScopeReport& scope : last_frame_scopes )
+			{
+				if( scope.m_name != nullptr && _name == scope.m_name )
+					return scope.m_counters;
+			}
+
+			return {};
+		}
+
+		void add_scope_counters( const char* _name, const Counters& _counters )
+		{
+			for( ScopeReport& scope : frame_scopes )
+			{
+				// Scopes are created with string literals, comparing the pointers is enough.
+				if( scope.m_name == nullptr )
+					scope.m_name = _name;
+				else if( scope.m_name != _name )
+					continue;
+
+				scope.m_counters.m_allocations += _counters.m_allocations;
+				scope.m_counters.m_bytes += _counters.m_bytes;
+				return;
+			}
+		}
+	}
+
+	AllocationScope::AllocationScope( const char* _name )
+		: m_name( _name )
+		, m_start( AllocationTracker::get_thread_counters() )
+	{
+	}
+
+	AllocationScope::~AllocationScope()
+	{
+		const AllocationTracker::Counters current{ AllocationTracker::get_thread_counters() };
+
+		AllocationTracker::add_scope_counters( m_name, { current.m_allocations - m_start.m_allocations, current.m_bytes - m_start.m_bytes } );
+	}
+}
+
+#if SPLITSMGR_ALLOCATION_TRACKING
+// Replacement of the global allocation functions. Nothing in here can allocate through new or it would recurse.
+// Over-aligned allocations keep the default implementation and aren't counted.
+void* operator new( size_t _size )
+{
+	SplitsMgr::AllocationTracker::on_allocation( _size );
+
+	if( void* ptr = std::malloc( _size > 0 ? _size : 1 ) )
+		return ptr;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new[]( size_t _size )
+{
+	return operator new( _size );
+}
+
+void* operator new( size_t _size, const std::nothrow_t& ) noexcept
+{
+	SplitsMgr::AllocationTracker::on_allocation( _size );
+	return std::malloc( _size > 0 ? _size : 1 );
+}
+
+void* operator new[]( size_t _size, const std::nothrow_t& _nothrow ) noexcept
+{
+	return operator new( _size, _nothrow );
+}
+
+void operator delete( void* _ptr ) noexcept
+{
+	std::free( _ptr );
+}
+
+void operator delete[]( void* _ptr ) noexcept
+{
+	std::free( _ptr );
+}
+
+void operator delete( void* _ptr, size_t ) noexcept
+{
+	std::free( _ptr );
+}
+
+void operator delete[]( void* _ptr, size_t ) noexcept
+{
+	std::free( _ptr );
+}
+
+void operator delete( void* _ptr, const std::nothrow_t& ) noexcept
+{
+	std::free( _ptr );
+}
+
+void operator delete[]( void* _ptr, const std::nothrow_t& ) noexcept
+{
+	std::free( _ptr );
+}
+#endif
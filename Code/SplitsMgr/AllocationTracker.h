@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Global operator new/delete are only hooked in debug builds, release builds report empty counters.
+#if defined( _DEBUG )
+#define SPLITSMGR_ALLOCATION_TRACKING 1
+#else
+#define SPLITSMGR_ALLOCATION_TRACKING 0
+#endif
+
+
+namespace SplitsMgr
+{
+	namespace AllocationTracker
+	{
+		static constexpr size_t max_scopes{ 16 };
+
+		struct Counters
+		{
+			uint64_t m_allocations{ 0 };
+			uint64_t m_bytes{ 0 };
+		};
+
+		struct ScopeReport
+		{
+			const char* m_name{ nullptr };
+			Counters	m_counters;
+		};
+		using ScopeReports = std::array< ScopeReport, max_scopes >;
+
+		/**
+		* @brief Count an allocation made on the calling thread. Called by the global operator new.
+		* @param _size The number of allocated bytes.
+		**/
+		void on_allocation( size_t _size );
+		/**
+		* @brief Counters of all the allocations made on the calling thread since the beginning of the program.
+		**/
+		Counters get_thread_counters();
+
+		/**
+		* @brief Mark the beginning of a frame, the counters of the previous one are kept until the end of this one.
+		**/
+		void begin_frame();
+		void end_frame();
+
+		const Counters& get_last_frame_counters();
+		const ScopeReports& get_last_frame_scopes();
+		Counters get_last_frame_scope( std::string_view _name );
+
+		/**
+		* @brief Add the allocations of a scope to the ones of the current frame. Scopes with the same name are summed.
+		**/
+		void add_scope_counters( const char* _name, const Counters& _counters );
+	}
+
+	/************************************************************************
+	* @brief Count the allocations made during its lifetime and add them to the current frame report under the given name.
+	************************************************************************/
+	class AllocationScope
+	{
+	public:
+		AllocationScope( const char* _name );
+		~AllocationScope();
+
+	private:
+		const char*						m_name{ nullptr };
+		AllocationTracker::Counters		m_start{};
+	};
+}
+
+#if SPLITSMGR_ALLOCATION_TRACKING
+#define SPLITSMGR_ALLOCATION_SCOPE( _name ) const SplitsMgr::AllocationScope allocation_scope{ _name }
+#else
+#define SPLITSMGR_ALLOCATION_SCOPE( _name )
+#endif
@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include <Externals/json/json.h>
+
+#include <FZN/Tools/Logging.h>
+
+#include "Backtest.h"
+#include "Clock.h"
+#include "LssReader.h"
+#include "RateModel.h"
+#include "SessionTable.h"
+#include "Stats.h"
+
+
+namespace SplitsMgr
+{
+	namespace Backtest
+	{
+		/**
+		* @brief Errors of all the predictions of the replayed lists.
+		**/
+		struct Results
+		{
+			std::array< std::vector< int32_t >, nb_models >	m_errors;		// Predicted minus actual remaining days.
+			uint64_t										m_nb_days{ 0 };
+			uint32_t										m_nb_lists{ 0 };
+			std::vector< std::pair< size_t, const char* > >	m_skipped;		// Index of each skipped file and the reason, logged once all the tasks are done.
+		};
+
+		/**
+		* @brief Split the command line in arguments, quoted ones can contain spaces.
+		**/
+		static std::vector< std::string > split_command_line( std::string_view _command_line )
+		{
+			std::vector< std::string > arguments;
+			std::string argument{};
+			bool quoted{ false };
+			bool has_argument{ false };
+
+			for( const char character : _command_line )
+			{
+				if( character == '"' )
+				{
+					quoted = !quoted;
+					has_argument = true;
+					continue;
+				}
+
+				if( ( character == ' ' || character == '\t' ) && quoted == false )
+				{
+					if( has_argument )
+						arguments.push_back( std::move( argument ) );
+
+					argument.clear();
+					has_argument = false;
+					continue;
+				}
+
+				argument.push_back( character );
+				has_argument = true;
+			}
+
+			if( has_argument )
+				arguments.push_back( std::move( argument ) );
+
+			return arguments;
+		}
+
+		static std::string get_extension( const std::filesystem::path& _path )
+		{
+			std::string extension{ _path.extension().string() };
+			std::ranges::transform( extension, extension.begin(), []( unsigned char _character ) { return static_cast< char >( std::tolower( _character ) ); } );
+
+			return extension;
+		}
+
+		static bool is_list_file( const std::filesystem::path& _path )
+		{
+			const std::string extension{ get_extension( _path ) };
+
+			return extension == ".json" || extension == ".lss";
+		}
+
+		static void add_list_files( const std::filesystem::path& _path, std::vector< std::filesystem::path >& _files )
+		{
+			std::error_code error{};
+
+			if( std::filesystem::is_directory( _path, error ) == false )
+			{
+				if( is_list_file( _path ) )
+					_files.push_back( _path );
+
+				return;
+			}
+
+			for( const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator( _path, error ) )
+			{
+				if( entry.is_regular_file( error ) && is_list_file( entry.path() ) )
+					_files.push_back( entry.path() );
+			}
+		}
+
+		/**
+		* @brief Check the types Game::read expects on a game of a json list, a wrong one would throw instead of being read.
+		**/
+		static bool is_json_game_valid( const Json::Value& _game )
+		{
+			auto is_null_or_string = []( const Json::Value& _value ) { return _value.isNull() || _value.isString(); };
+
+			if( _game.isObject() == false || _game[ "Estimate" ].isString() == false || is_null_or_string( _game[ "Name" ] ) == false || is_null_or_string( _game[ "State" ] ) == false )
+				return false;
+
+			const Json::Value& sessions{ _game[ "Sessions" ] };
+
+			if( sessions.isNull() )
+				return true;
+
+			if( sessions.isArray() == false )
+				return false;
+
+			for( const Json::Value& session : sessions )
+			{
+				if( session.isString() == false )
+					return false;
+			}
+
+			return true;
+		}
+
+		/**
+		* @brief Read a list saved by the app, with the reader of the app once the values it reads have been checked.
+		**/
+		static bool read_json_list( const std::filesystem::path& _path, Games& _games )
+		{
+			std::ifstream file{ _path };
+
+			if( file.is_open() == false )
+				return false;
+
+			Json::Value root{};
+			std::string errors{};
+
+			// The reader only throws past its nesting limit, which no list reaches.
+			try
+			{
+				if( Json::parseFromStream( Json::CharReaderBuilder{}, file, &root, &errors ) == false )
+					return false;
+			}
+			catch( const std::exception& )
+			{
+				return false;
+			}
+
+			if( root.isObject() == false || root[ "Games" ].isArray() == false )
+				return false;
+
+			const Json::Value& games{ root[ "Games" ] };
+			Utils::ParsingInfos parsing_infos{};
+			_games.reserve( games.size() );
+
+			for( const Json::Value& game : games )
+			{
+				if( is_json_game_valid( game ) == false )
+					return false;
+
+				// The covers aren't needed to replay the sessions, they aren't loaded.
+				Json::Value game_without_cover{ game };
+				game_without_cover.removeMember( "Cover" );
+
+				_games.emplace_back( parsing_infos.m_resource ).read( game_without_cover, parsing_infos );
+			}
+
+			return true;
+		}
+
+		/**
+		* @brief Read the segments of a LiveSplit splits file as games, with the estimates SplitsManager::read_lss gives them.
+		* The list is only over once the run has been completed: its last segment has been split in the last attempt.
+		**/
+		static bool read_lss_list( const std::filesystem::path& _path, Games& _games )
+		{
+			LssReader reader{};
+
+			if( reader.open( _path ) == false )
+				return false;
+
+			Utils::ParsingInfos parsing_infos{};
+			LssReader::Segment segment{};
+			SplitTime previous_personal_best{};
+			bool run_completed{ false };
+
+			while( reader.read_segment( segment ) )
+			{
+				Game::Desc desc{ segment.m_name };
+				desc.m_estimation = segment.get_estimate( previous_personal_best );
+
+				_games.emplace_back( desc, parsing_infos ).add_sessions( segment.m_sessions, Game::State::playing );
+				run_completed = segment.m_split_in_last_attempt;
+			}
+
+			// Every segment has been passed in a completed run, the ones without history too.
+			for( Game& game : _games )
+				game.set_state( run_completed ? Game::State::finished : Game::State::none );
+
+			return run_completed;
+		}
+
+		/**
+		* @brief Replay the history of a finished list day by day, as if the app was opened at the end of each of them.
+		* The games start without sessions and get the ones of each day, then the real stats are refreshed on the simulated clock, once without play rates and once with them.
+		* The simulated day only exists on the calling thread, so several lists can be replayed at the same time.
+		* @param _on_prediction Called as ( uint32_t _actual_days, const std::array< uint32_t, nb_models >& _predicted_days ) for each predicted day, in days from its next one.
+		* @param _cancelled Checked before each day, the replay stops once it's set.
+		* @return The number of replayed days, 0 if the list has no dated session or the replay has been cancelled.
+		**/
+		template< typename Function >
+		static uint32_t replay( const Games& _list, Function&& _on_prediction, const std::atomic< bool >* _cancelled = nullptr )
+		{
+			struct Session
+			{
+				uint32_t	m_game_id;
+				Split		m_split;
+			};
+
+			Utils::ParsingInfos parsing_infos{};
+			Games games{};
+			std::vector< Session > sessions{};
+			std::vector< uint32_t > remaining_sessions( _list.size(), 0 );
+
+			games.reserve( _list.size() );
+
+			for( uint32_t game_id{ 0 }; game_id < _list.size(); ++game_id )
+			{
+				const Game& game{ _list[ game_id ] };
+				const Splits& splits{ game.get_splits() };
+
+				// Games without sessions don't change during the replay, they already are in their final state.
+				Game::Desc desc{ game.get_name() };
+				desc.m_estimation = game.get_estimate();
+				desc.m_state = splits.empty() ? game.get_state() : Game::State::none;
+				games.emplace_back( desc, parsing_infos );
+
+				for( const Split& split : splits )
+					sessions.push_back( Session{ game_id, split } );
+
+				remaining_sessions[ game_id ] = static_cast< uint32_t >( splits.size() );
+			}
+
+			// Undated sessions have been played before the history, they're added on its first day.
+			std::ranges::stable_sort( sessions, {}, []( const Session& _session ) { return _session.m_split.m_day; } );
+
+			const auto first_dated{ std::ranges::find_if( sessions, []( const Session& _session ) { return _session.m_split.m_day != Split::no_date; } ) };
+
+			if( first_dated == sessions.end() )
+				return 0;
+
+			const Utils::DayNumber first_day{ first_dated->m_split.m_day };
+			const Utils::DayNumber last_day{ sessions.back().m_split.m_day };
+
+			static const RateModel no_rates{};		// Without valid rates, the stats predict from the average time per day since the first session.
+			SessionTable session_table{};
+			RateModel rates{};
+			Stats stats{};
+			Game* current_game{ nullptr };
+			std::array< uint32_t, nb_models > predicted_days{};
+			size_t next_session{ 0 };
+
+			session_table.rebuild( games );
+			stats.enable_forecast( false );
+
+			// The stats of a day are refreshed on the next one, once all its sessions are known.
+			Clock::SimulationScope clock{ Utils::to_date( first_day + 1 ) };
+
+			for( Utils::DayNumber day{ first_day }; day < last_day; ++day, clock.advance_days( 1 ) )
+			{
+				if( _cancelled != nullptr && *_cancelled )
+					return 0;
+
+				for( ; next_session < sessions.size() && sessions[ next_session ].m_split.m_day <= day; ++next_session )
+				{
+					const Session& session{ sessions[ next_session ] };
+					Game& game{ games[ session.m_game_id ] };
+
+					// A game is the current one until its last session, which gives it its final state.
+					const bool last_session{ --remaining_sessions[ session.m_game_id ] == 0 };
+					const Game::State state{ last_session ? _list[ session.m_game_id ].get_state() : Game::State::current };
+
+					if( current_game != nullptr && current_game != &game && current_game->is_current() )
+						current_game->set_state( Game::State::playing );
+
+					game.add_sessions( std::span< const Split >{ &session.m_split, 1 }, state );
+					current_game = &game;
+
+					session_table.add_session( session.m_game_id, session.m_split.m_seconds, session.m_split.m_day );
+					rates.add_session( session.m_split.m_day, session.m_split.m_seconds );
+				}
+
+				// Same order as SplitsManager::_refresh_run_stats, the days since the last session count as days without play.
+				rates.advance( Utils::today() );
+
+				if( static_cast< uint32_t >( day - first_day ) + 1 < min_history_days || rates.is_valid() == false )
+					continue;
+
+				stats.refresh( games, session_table, no_rates );
+				predicted_days[ static_cast< size_t >( Model::average ) ] = stats.get_remaining_days();
+
+				stats.refresh( games, session_table, rates );
+				predicted_days[ static_cast< size_t >( Model::rates ) ] = stats.get_remaining_days();
+
+				_on_prediction( Utils::days_between_dates( Utils::today(), last_day ), predicted_days );
+			}
+
+			return static_cast< uint32_t >( last_day - first_day ) + 1;
+		}
+
+		static void log_distribution( Model _model, std::span< const int32_t > _errors )
+		{
+			if( _errors.empty() )
+				return;
+
+			std::vector< uint32_t > absolute_errors( _errors.size() );
+			int64_t signed_sum{ 0 };
+			uint64_t absolute_sum{ 0 };
+
+			for( size_t prediction{ 0 }; prediction < _errors.size(); ++prediction )
+			{
+				absolute_errors[ prediction ] = static_cast< uint32_t >( std::abs( _errors[ prediction ] ) );
+				signed_sum += _errors[ prediction ];
+				absolute_sum += absolute_errors[ prediction ];
+			}
+
+			auto get_percentile = [ &absolute_errors ]( size_t _percent )
+			{
+				const auto nth{ absolute_errors.begin() + ( absolute_errors.size() - 1 ) * _percent / 100 };
+				std::ranges::nth_element( absolute_errors, nth );
+				return *nth;
+			};
+
+			const double nb_predictions{ static_cast< double >( _errors.size() ) };
+			const uint32_t median{ get_percentile( 50 ) };
+			const uint32_t p90{ get_percentile( 90 ) };
+			const uint32_t max{ *std::ranges::max_element( absolute_errors ) };
+
+			FZN_LOG( "%-8s %zu prediction(s) | mean error %.1f day(s) | bias %+.1f | median %u | P90 %u | max %u", get_model_str( _model ), _errors.size(), absolute_sum / nb_predictions, signed_sum / nb_predictions, median, p90, max );
+		}
+
+		bool is_list_finished( const Games& _games )
+		{
+			return _games.empty() == false && std::ranges::all_of( _games, []( const Game& _game ) { return _game.are_sessions_over(); } );
+		}
+
+		Score score( const Games& _games, const std::atomic< bool >* _cancelled )
+		{
+			Score list_score{};
+
+			if( is_list_finished( _games ) == false )
+				return list_score;
+
+			std::array< uint64_t, nb_models > error_sums{};
+
+			const uint32_t nb_days{ replay( _games, [ &list_score, &error_sums ]( uint32_t _actual_days, const std::array< uint32_t, nb_models >& _predicted_days )
+			{
+				for( size_t model{ 0 }; model < nb_models; ++model )
+					error_sums[ model ] += static_cast< uint64_t >( std::abs( static_cast< int64_t >( _predicted_days[ model ] ) - _actual_days ) );
+
+				++list_score.m_nb_predictions;
+			}, _cancelled ) };
+
+			if( nb_days == 0 )
+				return Score{};
+
+			for( size_t model{ 0 }; model < nb_models && list_score.m_nb_predictions > 0; ++model )
+				list_score.m_mean_errors[ model ] = error_sums[ model ] / static_cast< double >( list_score.m_nb_predictions );
+
+			return list_score;
+		}
+
+		bool read_list( const std::filesystem::path& _path, Games& _games )
+		{
+			_games.clear();
+
+			const bool read{ get_extension( _path ) == ".lss" ? read_lss_list( _path, _games ) : read_json_list( _path, _games ) };
+
+			return read && is_list_finished( _games );
+		}
+
+		/**
+		* @brief Replay the files not taken by the other tasks yet, until there are none left.
+		* @param _next_file Index of the next file to replay, shared by all the tasks.
+		**/
+		static Results replay_files( const std::vector< std::filesystem::path >& _files, std::atomic< size_t >& _next_file )
+		{
+			Results results{};
+			Games games{};
+
+			for( size_t file_index{ _next_file++ }; file_index < _files.size(); file_index = _next_file++ )
+			{
+				if( read_list( _files[ file_index ], games ) == false )
+				{
+					results.m_skipped.emplace_back( file_index, "it couldn't be read or isn't finished" );
+					continue;
+				}
+
+				const uint32_t nb_days{ replay( games, [ &results ]( uint32_t _actual_days, const std::array< uint32_t, nb_models >& _predicted_days )
+				{
+					for( size_t model{ 0 }; model < nb_models; ++model )
+						results.m_errors[ model ].push_back( static_cast< int32_t >( _predicted_days[ model ] ) - static_cast< int32_t >( _actual_days ) );
+				} ) };
+
+				if( nb_days == 0 )
+				{
+					results.m_skipped.emplace_back( file_index, "it doesn't have any dated session" );
+					continue;
+				}
+
+				results.m_nb_days += nb_days;
+				++results.m_nb_lists;
+			}
+
+			return results;
+		}
+
+		bool is_requested( std::string_view _command_line )
+		{
+			const std::vector< std::string > arguments{ split_command_line( _command_line ) };
+
+			return std::ranges::find( arguments, "--backtest" ) != arguments.end();
+		}
+
+		int run( std::string_view _command_line )
+		{
+			std::vector< std::filesystem::path > files;
+			bool list_arguments{ false };
+
+			for( const std::string& argument : split_command_line( _command_line ) )
+			{
+				if( argument == "--backtest" )
+					list_arguments = true;
+				else if( list_arguments )
+					add_list_files( argument, files );
+			}
+
+			if( files.empty() )
+			{
+				FZN_LOG( "Backtest: no .json or .lss file given after --backtest." );
+				return 1;
+			}
+
+			FZN_LOG( "Backtesting %zu file(s)...", files.size() );
+			const std::chrono::steady_clock::time_point start_time{ std::chrono::steady_clock::now() };
+
+			// Each task replays whole lists on its own simulated day, the lists are shared out as the tasks get free.
+			const size_t nb_tasks{ std::min< size_t >( std::max( std::thread::hardware_concurrency(), 1u ), files.size() ) };
+			std::atomic< size_t > next_file{ 0 };
+			std::vector< std::future< Results > > tasks;
+
+			for( size_t task{ 0 }; task < nb_tasks; ++task )
+				tasks.push_back( std::async( std::launch::async, &replay_files, std::cref( files ), std::ref( next_file ) ) );
+
+			Results total{};
+
+			for( std::future< Results >& task : tasks )
+			{
+				Results results{ task.get() };
+
+				for( size_t model{ 0 }; model < nb_models; ++model )
+					total.m_errors[ model ].insert( total.m_errors[ model ].end(), results.m_errors[ model ].begin(), results.m_errors[ model ].end() );
+
+				total.m_skipped.insert( total.m_skipped.end(), results.m_skipped.begin(), results.m_skipped.end() );
+				total.m_nb_days += results.m_nb_days;
+				total.m_nb_lists += results.m_nb_lists;
+			}
+
+			const std::chrono::duration< double, std::milli > duration{ std::chrono::steady_clock::now() - start_time };
+
+			std::ranges::sort( total.m_skipped, {}, &std::pair< size_t, const char* >::first );
+
+			for( const auto& [ file_index, reason ] : total.m_skipped )
+				FZN_LOG( "Skipped %s: %s.", files[ file_index ].string().c_str(), reason );
+
+			FZN_LOG( "%u list(s) and %llu day(s) replayed in %.1f ms on %zu task(s).", total.m_nb_lists, static_cast< unsigned long long >( total.m_nb_days ), duration.count(), nb_tasks );
+
+			for( size_t model{ 0 }; model < nb_models; ++model )
+				log_distribution( static_cast< Model >( model ), total.m_errors[ model ] );
+
+			return total.m_nb_lists > 0 ? 0 : 1;
+		}
+
+		Scorer::~Scorer()
+		{
+			cancel();
+		}
+
+		void Scorer::start( const Games& _games )
+		{
+			cancel();
+			m_score = Score{};
+
+			if( is_list_finished( _games ) == false )
+				return;
+
+			// The task works on its own copy, the games of the app can be edited while it runs.
+			m_games = _games;
+			m_cancelled = false;
+			m_task = std::async( std::launch::async, [ this ]() { return score( m_games, &m_cancelled ); } );
+		}
+
+		void Scorer::cancel()
+		{
+			if( m_task.valid() == false )
+				return;
+
+			m_cancelled = true;
+			m_task.wait();
+			m_task = {};
+		}
+
+		void Scorer::update()
+		{
+			if( m_task.valid() == false || m_task.wait_for( std::chrono::seconds{ 0 } ) != std::future_status::ready )
+				return;
+
+			m_score = m_task.get();
+		}
+
+		const char* get_model_str( Model _model )
+		{
+			switch( _model )
+			{
+				case Model::average:	return "Average";
+				case Model::rates:		return "Rates";
+				default:				return "Unknown";
+			}
+		}
+	}
+}
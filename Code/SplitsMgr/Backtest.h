@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <string_view>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Score the end date predictions on finished lists, by replaying their history day by day.
+	* The clock is simulated from the first day of the list, each day gets its sessions and the stats of the list are refreshed like the app does.
+	* The remaining days they predict are compared with the day the list really ended on.
+	************************************************************************/
+	namespace Backtest
+	{
+		enum class Model
+		{
+			average,		// Remaining time over the average play time per day since the first session, what Stats uses without play rates.
+			rates,			// Weekday and recent play rates, see RateModel.
+			COUNT
+		};
+
+		static constexpr size_t nb_models{ static_cast< size_t >( Model::COUNT ) };
+		static constexpr uint32_t min_history_days{ 7 };		// Predictions start after a week, so every weekday has a rate.
+
+		/**
+		* @brief Mean absolute error of each model on a list, in days.
+		**/
+		struct Score
+		{
+			uint32_t						m_nb_predictions{ 0 };
+			std::array< double, nb_models >	m_mean_errors{};
+		};
+
+		/**
+		* @brief True if every game of the list is finished or abandonned, its last session being the day it ended on.
+		**/
+		bool is_list_finished( const Games& _games );
+		/**
+		* @brief Mean error of each model on a finished list, like the loaded one. Only the calling thread's day is simulated, the clock of the app isn't touched.
+		* @param _cancelled Checked before each replayed day, an empty score is returned once it's set.
+		**/
+		Score score( const Games& _games, const std::atomic< bool >* _cancelled = nullptr );
+
+		/************************************************************************
+		* @brief Score the loaded list in a background task, the result is picked up once it's done without blocking the frame, like Forecaster.
+		************************************************************************/
+		class Scorer
+		{
+		public:
+			Scorer() = default;
+			~Scorer();
+			Scorer( const Scorer& ) = delete;
+			Scorer& operator=( const Scorer& ) = delete;
+
+			/**
+			* @brief Start scoring a copy of the games, the running task is cancelled. Lists that aren't finished get an empty score.
+			**/
+			void start( const Games& _games );
+			void cancel();
+			/**
+			* @brief Pick up the score if the task is done. Called each frame, it never waits for it.
+			**/
+			void update();
+
+			bool			is_running() const		{ return m_task.valid(); }
+			const Score&	get_score() const		{ return m_score; }
+
+		private:
+			Games					m_games;
+			std::future< Score >	m_task;
+			std::atomic< bool >		m_cancelled{ false };
+			Score					m_score{};
+		};
+
+		/**
+		* @brief Read the games of a .json list or .lss splits file.
+		* @return False if the file couldn't be read or the list isn't finished, its end day being unknown.
+		**/
+		bool read_list( const std::filesystem::path& _path, Games& _games );
+
+		/**
+		* @brief True if the command line asks for a backtest instead of starting the app.
+		**/
+		bool is_requested( std::string_view _command_line );
+		/**
+		* @brief Replay all the lists given after --backtest, files or folders, and log the error distribution of each model.
+		* @return The exit code of the program.
+		**/
+		int run( std::string_view _command_line );
+
+		const char* get_model_str( Model _model );
+	}
+}
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tinyXML2/tinyxml2.h>
+
+#include <FZN/Tools/Logging.h>
+
+#include "Benchmark.h"
+#include "LssReader.h"
+#include "Reduction.h"
+#include "SessionTable.h"
+#include "Stats.h"
+
+
+namespace SplitsMgr
+{
+	namespace Benchmark
+	{
+		static constexpr uint32_t nb_runs{ 5 };									// The best run is kept, the others having been slowed down by the rest of the system.
+		static constexpr size_t values_per_run{ 16 * 1024 * 1024 };				// Small inputs are summarized several times per run so every run takes about as long.
+		static constexpr std::array< size_t, 4 > session_counts{ 16, 256, 4096, 1024 * 1024 };
+
+		/**
+		* @brief Number of attempts and segments of the generated splits files, the last one putting the whole history in a single segment.
+		**/
+		struct LssSize
+		{
+			uint32_t m_nb_attempts;
+			uint32_t m_nb_segments;
+		};
+		static constexpr std::array< LssSize, 4 > lss_sizes{ LssSize{ 1000, 40 }, LssSize{ 10000, 40 }, LssSize{ 100000, 40 }, LssSize{ 100000, 1 } };
+
+		static volatile uint64_t g_sink{ 0 };		// Written with the results so the compiler can't remove the loops.
+
+		/**
+		* @brief Call a function the given number of times in a row and return the duration of the fastest run, in nanoseconds.
+		**/
+		template< typename Function >
+		static double get_best_duration( size_t _nb_repeats, Function&& _function )
+		{
+			double best_duration{ std::numeric_limits< double >::max() };
+
+			for( uint32_t run{ 0 }; run < nb_runs; ++run )
+			{
+				const auto start_time{ std::chrono::steady_clock::now() };
+
+				for( size_t repeat{ 0 }; repeat < _nb_repeats; ++repeat )
+					g_sink = g_sink + _function();
+
+				const std::chrono::duration< double, std::nano > duration{ std::chrono::steady_clock::now() - start_time };
+				best_duration = std::min( best_duration, duration.count() );
+			}
+
+			return best_duration;
+		}
+
+		/**
+		* @brief Time a function on the given number of values and return the best duration per value, in nanoseconds.
+		**/
+		template< typename Function >
+		static double measure( size_t _nb_values, Function&& _function )
+		{
+			const size_t nb_values{ std::max< size_t >( _nb_values, 1 ) };
+			const size_t nb_repeats{ std::max< size_t >( values_per_run / nb_values, 1 ) };
+
+			return get_best_duration( nb_repeats, _function ) / static_cast< double >( nb_repeats * nb_values );
+		}
+
+		/**
+		* @brief The loop Stats used on the sessions table before the reduction kernels.
+		**/
+		static uint64_t summarize_seconds_loop( const std::vector< uint32_t >& _seconds )
+		{
+			uint64_t game_seconds{ 0 };
+			uint32_t shortest_session{ UINT32_MAX };
+			uint32_t longest_session{ 0 };
+
+			for( const uint32_t session_seconds : _seconds )
+			{
+				game_seconds += session_seconds;
+				shortest_session = std::min( shortest_session, session_seconds );
+				longest_session = std::max( longest_session, session_seconds );
+			}
+
+			return game_seconds + shortest_session + longest_session;
+		}
+
+		/**
+		* @brief The loop Game used on its splits before the reduction kernels.
+		**/
+		static uint64_t summarize_splits_loop( const Splits& _splits )
+		{
+			SplitTime total_time{};
+			SplitTime longest_session{};
+			SplitTime shortest_session{ SplitTime::max() };
+
+			for( const Split& split : _splits )
+			{
+				const SplitTime segment_time{ split.get_segment_time() };
+				total_time += segment_time;
+
+				if( longest_session < segment_time )
+					longest_session = segment_time;
+
+				if( shortest_session > segment_time )
+					shortest_session = segment_time;
+			}
+
+			return static_cast< uint64_t >( ( total_time + longest_session + shortest_session ).count() );
+		}
+
+		static uint64_t get_result( const Reduction::Summary& _summary )
+		{
+			return _summary.m_sum + _summary.m_min + _summary.m_max + _summary.m_argmin + _summary.m_argmax;
+		}
+
+		/**
+		* @brief Compare the reduction kernels available on this CPU with the loops they replaced, on the two layouts the stats read.
+		**/
+		static void run_reduction()
+		{
+			FZN_LOG( "Session reductions, in ns per session (best of %u runs):", nb_runs );
+
+			// Sessions from 10 minutes to 5 hours, the seed is fixed so every machine summarizes the same values.
+			std::mt19937 generator{ 1 };
+			std::uniform_int_distribution< uint32_t > session_seconds{ 10 * 60, 5 * 60 * 60 };
+			const Reduction::Instructions best_instructions{ Reduction::get_instructions() };
+
+			for( const size_t nb_sessions : session_counts )
+			{
+				std::vector< uint32_t > seconds( nb_sessions );
+				Splits splits( nb_sessions );
+
+				for( size_t session{ 0 }; session < nb_sessions; ++session )
+				{
+					seconds[ session ] = session_seconds( generator );
+					splits[ session ].m_seconds = seconds[ session ];
+				}
+
+				FZN_LOG( "%zu session(s):", nb_sessions );
+				FZN_LOG( "  %-8s seconds %6.3f | splits %6.3f", "Loop", measure( nb_sessions, [&]() { return summarize_seconds_loop( seconds ); } ), measure( nb_sessions, [&]() { return summarize_splits_loop( splits ); } ) );
+
+				for( int instructions{ 0 }; instructions <= static_cast< int >( best_instructions ); ++instructions )
+				{
+					const Reduction::Instructions kernel{ static_cast< Reduction::Instructions >( instructions ) };
+
+					const double seconds_duration{ measure( nb_sessions, [&]() { return get_result( Reduction::summarize( std::span< const uint32_t >{ seconds }, kernel ) ); } ) };
+					const double splits_duration{ measure( nb_sessions, [&]() { return get_result( Reduction::summarize( std::span< const Split >{ splits }, kernel ) ); } ) };
+
+					FZN_LOG( "  %-8s seconds %6.3f | splits %6.3f", Reduction::get_instructions_str( kernel ), seconds_duration, splits_duration );
+				}
+			}
+		}
+
+		/**
+		* @brief Write a splits file like LiveSplit does, every attempt playing a session of the segment reached at that point of the run.
+		**/
+		static bool write_lss( const std::filesystem::path& _path, const LssSize& _size )
+		{
+			static constexpr Utils::DayNumber first_day{ 7305 };		// 1990-01-01, with several attempts per day the last ones are still in the past.
+			static constexpr uint32_t attempts_per_day{ 10 };
+
+			std::ofstream file{ _path, std::ios::binary };
+
+			if( file.is_open() == false )
+				return false;
+
+			char line[ 256 ];
+
+			file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<Run version=\"1.7.0\">\n  <GameName>Benchmark</GameName>\n  <CategoryName>1Y1G</CategoryName>\n";
+			file << "  <AttemptCount>" << _size.m_nb_attempts << "</AttemptCount>\n  <AttemptHistory>\n";
+
+			for( uint32_t attempt{ 1 }; attempt <= _size.m_nb_attempts; ++attempt )
+			{
+				const SplitDate date{ Utils::to_date( first_day + static_cast< Utils::DayNumber >( attempt / attempts_per_day ) ) };
+				snprintf( line, sizeof( line ), "    <Attempt id=\"%u\" started=\"%02u/%02u/%d 18:00:00\" isStartedSynced=\"True\" ended=\"%02u/%02u/%d 19:30:00\" isEndedSynced=\"True\" />\n", attempt
+					, static_cast< unsigned >( date.month() ), static_cast< unsigned >( date.day() ), static_cast< int >( date.year() )
+					, static_cast< unsigned >( date.month() ), static_cast< unsigned >( date.day() ), static_cast< int >( date.year() ) );
+				file << line;
+			}
+
+			file << "  </AttemptHistory>\n  <Segments>\n";
+
+			const uint32_t attempts_per_segment{ ( _size.m_nb_attempts + _size.m_nb_segments - 1 ) / _size.m_nb_segments };
+
+			for( uint32_t segment{ 0 }; segment < _size.m_nb_segments; ++segment )
+			{
+				file << "    <Segment>\n      <Name>Game " << segment << "</Name>\n      <Icon />\n      <SplitTimes>\n        <SplitTime name=\"Personal Best\" />\n      </SplitTimes>\n      <BestSegmentTime />\n      <SegmentHistory>\n";
+
+				const uint32_t last_attempt{ std::min( ( segment + 1 ) * attempts_per_segment, _size.m_nb_attempts ) };
+
+				for( uint32_t attempt{ segment * attempts_per_segment + 1 }; attempt <= last_attempt; ++attempt )
+					file << "        <Time id=\"" << attempt << "\">\n          <RealTime>01:30:00.0000000</RealTime>\n        </Time>\n";
+
+				file << "      </SegmentHistory>\n    </Segment>\n";
+			}
+
+			file << "  </Segments>\n  <AutoSplitterSettings />\n</Run>\n";
+
+			return file.good();
+		}
+
+		/**
+		* @brief Compare the streaming reader of the splits files with loading them as a single document, on files with thousands of attempts.
+		**/
+		static void run_lss()
+		{
+			FZN_LOG( "LiveSplit splits files, in ms (best of %u runs):", nb_runs );
+
+			const std::filesystem::path path{ std::filesystem::temp_directory_path() / "SplitsMgr_benchmark.lss" };
+
+			for( const LssSize& size : lss_sizes )
+			{
+				if( write_lss( path, size ) == false )
+				{
+					FZN_LOG( "Couldn't write %s.", path.string().c_str() );
+					return;
+				}
+
+				const double file_size{ static_cast< double >( std::filesystem::file_size( path ) ) / ( 1024. * 1024. ) };
+				LssReader reader{};
+				LssReader::Segment segment{};
+
+				const double streamed_duration{ get_best_duration( 1, [&]()
+				{
+					uint64_t nb_sessions{ 0 };
+					reader.open( path );
+
+					while( reader.read_segment( segment ) )
+						nb_sessions += segment.m_sessions.size();
+
+					return nb_sessions;
+				} ) };
+
+				const double document_duration{ get_best_duration( 1, [&]()
+				{
+					tinyxml2::XMLDocument document{};
+					return static_cast< uint64_t >( document.LoadFile( path.string().c_str() ) );
+				} ) };
+
+				FZN_LOG( "  %6u attempt(s), %2u segment(s), %5.1f MB: streamed %7.1f | whole document %7.1f", size.m_nb_attempts, size.m_nb_segments, file_size, streamed_duration / 1e6, document_duration / 1e6 );
+			}
+
+			std::error_code error{};
+			std::filesystem::remove( path, error );
+		}
+
+		/**
+		* @brief Check that a list of more than 10,000 hours is read, summed and written without overflowing the times.
+		* @return False if one of the totals is wrong.
+		**/
+		static bool check_time_limits()
+		{
+			static constexpr uint32_t nb_games{ 25 };
+			static constexpr uint32_t sessions_per_game{ 250 };
+			static constexpr SplitTime session_time{ std::chrono::hours{ 2 } };
+			static constexpr SplitTime game_time{ session_time * sessions_per_game };
+			static constexpr SplitTime list_time{ game_time * nb_games };
+			static constexpr Utils::DayNumber first_day{ 10957 };	// 2000-01-01, a session per day.
+
+			Utils::ParsingInfos parsing_infos{};
+			Games games{};
+			games.reserve( nb_games );
+
+			std::vector< Split > sessions( sessions_per_game );
+
+			for( uint32_t slot{ 0 }; slot < nb_games; ++slot )
+			{
+				Game::Desc desc{ "Game " + std::to_string( slot ) };
+				desc.m_estimation = Utils::parse_time( Utils::time_to_str( game_time ) );
+
+				for( uint32_t session{ 0 }; session < sessions_per_game; ++session )
+				{
+					sessions[ session ].set_segment_time( session_time );
+					sessions[ session ].m_day = first_day + static_cast< Utils::DayNumber >( slot * sessions_per_game + session );
+				}
+
+				Game& game{ games.emplace_back( desc, parsing_infos ) };
+				game.add_sessions( sessions, Game::State::finished );
+				parsing_infos.m_total_time += game.get_played();
+			}
+
+			SessionTable session_table{};
+			session_table.rebuild( games );
+
+			StatsPipeline pipeline{};
+			pipeline.run( games, session_table );
+
+			const RunTotals& run{ pipeline.get< RunTotals >() };
+			bool valid{ true };
+
+			auto check = [ &valid ]( bool _condition, const char* _error )
+			{
+				if( _condition )
+					return;
+
+				FZN_LOG( "Time limits: %s", _error );
+				valid = false;
+			};
+
+			check( parsing_infos.m_total_time == list_time, "The run time of a long list overflowed while it was read." );
+			check( run.m_played == list_time && run.m_estimate == list_time && run.m_estimated_final_time == list_time, "The run totals of a long list overflowed." );
+			check( pipeline.get< GameRecords >().m_longest_sessions.m_time == session_time, "The session averages of a long list overflowed." );
+			check( Utils::time_to_str( list_time ) == "12500:00:00" && Utils::parse_time( Utils::time_to_str( list_time ) ) == list_time, "A long run time isn't written or parsed back correctly." );
+
+			FZN_LOG( "Time limits: %u game(s) of %u session(s) %s.", nb_games, sessions_per_game, valid ? "summed without overflow" : "FAILED" );
+			return valid;
+		}
+
+		bool is_requested( std::string_view _command_line )
+		{
+			return _command_line.find( "--benchmark" ) != std::string_view::npos;
+		}
+
+		int run( std::string_view /*_command_line*/ )
+		{
+			const bool time_limits_valid{ check_time_limits() };
+
+			run_reduction();
+			run_lss();
+
+			return time_limits_valid ? 0 : 1;
+		}
+	}
+}
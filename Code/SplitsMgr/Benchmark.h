@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string_view>
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Headless timings of the hot paths of the app, on generated data so the results can be compared between machines.
+	************************************************************************/
+	namespace Benchmark
+	{
+		/**
+		* @brief True if the command line asks for the benchmarks instead of starting the app.
+		**/
+		bool is_requested( std::string_view _command_line );
+		/**
+		* @brief Check that a long list doesn't overflow the times, then run all the benchmarks and log their timings.
+		* @return The exit code of the program, 1 if the check failed.
+		**/
+		int run( std::string_view _command_line );
+	}
+}
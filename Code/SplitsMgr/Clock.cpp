@@ -0,0 +1,110 @@
+#include "Clock.h"
+
+
+namespace SplitsMgr
+{
+	namespace Clock
+	{
+		static Mode									mode{ Mode::system };
+		static Utils::DayNumber						current_day{ Utils::no_day };
+		static std::chrono::system_clock::time_point next_midnight{};		// Past this point, the system day has to be read again.
+		static thread_local Utils::DayNumber		scoped_day{ Utils::no_day };	// Day of the SimulationScope of the calling thread, it overrides the clock of the app.
+
+		static void read_system_day()
+		{
+			const std::chrono::system_clock::time_point now{ std::chrono::system_clock::now() };
+
+			if( Utils::is_day_valid( current_day ) && now < next_midnight )
+				return;
+
+			const std::chrono::sys_days day{ std::chrono::floor< std::chrono::days >( now ) };
+			current_day = static_cast< Utils::DayNumber >( day.time_since_epoch().count() );
+			next_midnight = day + std::chrono::days{ 1 };
+		}
+
+		void update()
+		{
+			if( mode == Mode::system )
+				read_system_day();
+		}
+
+		SplitDate today()
+		{
+			return Utils::to_date( get_day() );
+		}
+
+		Utils::DayNumber get_day()
+		{
+			if( Utils::is_day_valid( scoped_day ) )
+				return scoped_day;
+
+			if( Utils::is_day_valid( current_day ) == false )
+				read_system_day();
+
+			return current_day;
+		}
+
+		Mode get_mode()
+		{
+			return Utils::is_day_valid( scoped_day ) ? Mode::simulated : mode;
+		}
+
+		void use_system_clock()
+		{
+			mode = Mode::system;
+			current_day = Utils::no_day;
+			read_system_day();
+		}
+
+		void set_fixed_day( const SplitDate& _day )
+		{
+			mode = Mode::fixed;
+			current_day = Utils::to_day_number( _day );
+		}
+
+		void set_simulated_day( const SplitDate& _day )
+		{
+			mode = Mode::simulated;
+			current_day = Utils::to_day_number( _day );
+		}
+
+		void advance_days( int _nb_days )
+		{
+			if( mode != Mode::simulated )
+				return;
+
+			current_day += _nb_days;
+		}
+
+		SimulationScope::SimulationScope( const SplitDate& _day )
+			: m_previous_day( scoped_day )
+		{
+			scoped_day = Utils::to_day_number( _day );
+		}
+
+		SimulationScope::~SimulationScope()
+		{
+			scoped_day = m_previous_day;
+		}
+
+		void SimulationScope::advance_days( int _nb_days )
+		{
+			scoped_day += _nb_days;
+		}
+
+		const char* get_mode_str( Mode _mode )
+		{
+			switch( _mode )
+			{
+				case Mode::system:
+					return "System";
+				case Mode::fixed:
+					return "Fixed";
+				case Mode::simulated:
+					return "Simulated";
+				default:
+					return "COUNT";
+			};
+		}
+	}
+}
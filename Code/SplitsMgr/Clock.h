@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Utils.h"
+
+
+namespace SplitsMgr
+{
+	namespace Clock
+	{
+		enum class Mode
+		{
+			system,			// Current day of the system, read once per frame.
+			fixed,			// Always the same day.
+			simulated,		// Starts on a given day and only moves when told to.
+			COUNT
+		};
+
+		/**
+		* @brief Read the system clock if needed, called once at the beginning of each frame so every date computed during the frame uses the same day.
+		**/
+		void update();
+
+		/**
+		* @brief The current day, as of the last update. Doesn't read the system clock unless no update has been made yet.
+		**/
+		SplitDate today();
+		Utils::DayNumber get_day();
+		Mode get_mode();
+
+		void use_system_clock();
+		/**
+		* @brief Freeze the current day, stats and predictions don't depend on when they're computed anymore.
+		**/
+		void set_fixed_day( const SplitDate& _day );
+		/**
+		* @brief Start a simulated calendar on the given day, it is then moved with advance_days.
+		**/
+		void set_simulated_day( const SplitDate& _day );
+		void advance_days( int _nb_days );
+
+		/**
+		* @brief Simulate the calendar from the given day on the calling thread while the scope lives, the clock of the app and the other threads aren't affected.
+		* Several lists can be replayed at the same time this way, each task having its own day.
+		**/
+		class SimulationScope
+		{
+		public:
+			explicit SimulationScope( const SplitDate& _day );
+			~SimulationScope();
+
+			SimulationScope( const SimulationScope& ) = delete;
+			SimulationScope& operator=( const SimulationScope& ) = delete;
+
+			void advance_days( int _nb_days );
+
+		private:
+			Utils::DayNumber	m_previous_day{ Utils::no_day };		// Day of the scope this one is nested in, if any.
+		};
+
+		const char* get_mode_str( Mode _mode );
+	}
+}
@@ -0,0 +1,172 @@
+#include <array>
+
+#include "CsvReader.h"
+
+
+namespace SplitsMgr
+{
+	bool CsvReader::open( const std::filesystem::path& _path )
+	{
+		close();
+
+		m_file.open( _path, std::ios::binary );
+
+		if( m_file.is_open() == false )
+			return false;
+
+		m_chunk.resize( chunk_size );
+		_fill_chunk();
+
+		// Skipping the UTF-8 byte order mark added by some sheet editors.
+		if( m_chunk_end >= 3 && m_chunk[ 0 ] == '\xEF' && m_chunk[ 1 ] == '\xBB' && m_chunk[ 2 ] == '\xBF' )
+			m_cursor = 3;
+
+		_detect_separator();
+		return true;
+	}
+
+	void CsvReader::close()
+	{
+		m_file.close();
+		m_file.clear();
+		m_cursor = 0;
+		m_chunk_end = 0;
+		m_line = 0;
+		m_next_line = 1;
+		m_separator = ',';
+	}
+
+	bool CsvReader::read_record( std::vector< std::string_view >& _fields )
+	{
+		_fields.clear();
+		m_record.clear();
+		m_field_ends.clear();
+
+		if( _peek_char() < 0 )
+			return false;
+
+		m_line = m_next_line;
+		bool in_quotes{ false };
+
+		for( int character{ _next_char() }; character >= 0; character = _next_char() )
+		{
+			if( in_quotes )
+			{
+				if( character != '"' )
+				{
+					if( character == '\n' )
+						++m_next_line;
+
+					m_record += static_cast< char >( character );
+				}
+				// Two quotes inside a quoted field are an escaped quote.
+				else if( _peek_char() == '"' )
+				{
+					_next_char();
+					m_record += '"';
+				}
+				else
+					in_quotes = false;
+
+				continue;
+			}
+
+			if( character == '"' )
+				in_quotes = true;
+			else if( character == m_separator )
+				m_field_ends.push_back( m_record.size() );
+			else if( character == '\n' || character == '\r' )
+			{
+				if( character == '\r' && _peek_char() == '\n' )
+					_next_char();
+
+				++m_next_line;
+				break;
+			}
+			else
+				m_record += static_cast< char >( character );
+		}
+
+		m_field_ends.push_back( m_record.size() );
+
+		// The views are only created once the record is complete, appending to it could have moved its contents.
+		const std::string_view record{ m_record };
+		size_t field_begin{ 0 };
+
+		for( const size_t field_end : m_field_ends )
+		{
+			_fields.push_back( record.substr( field_begin, field_end - field_begin ) );
+			field_begin = field_end;
+		}
+
+		return true;
+	}
+
+	int CsvReader::_next_char()
+	{
+		if( m_cursor >= m_chunk_end && _fill_chunk() == false )
+			return -1;
+
+		return static_cast< unsigned char >( m_chunk[ m_cursor++ ] );
+	}
+
+	int CsvReader::_peek_char()
+	{
+		if( m_cursor >= m_chunk_end && _fill_chunk() == false )
+			return -1;
+
+		return static_cast< unsigned char >( m_chunk[ m_cursor ] );
+	}
+
+	bool CsvReader::_fill_chunk()
+	{
+		m_cursor = 0;
+		m_chunk_end = 0;
+
+		if( m_file.is_open() == false || m_file.eof() )
+			return false;
+
+		m_file.read( m_chunk.data(), static_cast< std::streamsize >( m_chunk.size() ) );
+		m_chunk_end = static_cast< size_t >( m_file.gcount() );
+
+		return m_chunk_end > 0;
+	}
+
+	void CsvReader::_detect_separator()
+	{
+		static constexpr std::array< char, 3 > candidates{ ',', ';', '\t' };
+		std::array< size_t, candidates.size() > counts{};
+		bool in_quotes{ false };
+
+		// Only looking at the header in the first chunk, it is enough for any sensible header.
+		for( size_t index{ m_cursor }; index < m_chunk_end; ++index )
+		{
+			const char character{ m_chunk[ index ] };
+
+			if( character == '"' )
+				in_quotes = !in_quotes;
+
+			if( in_quotes )
+				continue;
+
+			if( character == '\n' || character == '\r' )
+				break;
+
+			for( size_t candidate{ 0 }; candidate < candidates.size(); ++candidate )
+			{
+				if( character == candidates[ candidate ] )
+					++counts[ candidate ];
+			}
+		}
+
+		size_t best{ 0 };
+
+		for( size_t candidate{ 1 }; candidate < candidates.size(); ++candidate )
+		{
+			if( counts[ candidate ] > counts[ best ] )
+				best = candidate;
+		}
+
+		m_separator = candidates[ best ];
+	}
+}
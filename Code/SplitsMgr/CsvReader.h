@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Read a CSV file record by record, following RFC 4180: quoted fields can hold separators, line breaks and doubled quotes.
+	* The file is read in fixed size chunks, only the current chunk and the current record are kept in memory.
+	************************************************************************/
+	class CsvReader
+	{
+	public:
+		static constexpr size_t chunk_size{ 64 * 1024 };
+
+		/**
+		* @brief Open the file and guess the separator from its first line, sheets exported with a french locale use semicolons.
+		**/
+		bool open( const std::filesystem::path& _path );
+		void close();
+
+		/**
+		* @brief Read the next record of the file.
+		* @param [out] _fields The fields of the record, unquoted. They're only valid until the next call.
+		* @return False once the end of the file has been reached.
+		**/
+		bool read_record( std::vector< std::string_view >& _fields );
+
+		char get_separator() const		{ return m_separator; }
+		size_t get_line() const			{ return m_line; }
+
+	private:
+		/**
+		* @brief Next character of the file, reading a new chunk when the current one is over.
+		* @return The character, or -1 at the end of the file.
+		**/
+		int _next_char();
+		int _peek_char();
+		bool _fill_chunk();
+		void _detect_separator();
+
+		std::ifstream			m_file;
+		std::vector< char >		m_chunk;
+		size_t					m_cursor{ 0 };
+		size_t					m_chunk_end{ 0 };
+
+		char					m_separator{ ',' };
+		size_t					m_line{ 0 };				// Line of the file where the last read record starts, for error messages.
+		size_t					m_next_line{ 1 };
+
+		std::string				m_record;					// Unquoted contents of the current record, the fields point into it.
+		std::vector< size_t >	m_field_ends;
+	};
+}
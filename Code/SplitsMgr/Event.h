@@ -11,11 +11,15 @@ namespace SplitsMgr
 		enum class Type
 		{
 			session_added,				// A session has been added to a game. (m_game_event)
+			session_edited,				// The time or date of a session of a game has been changed. (m_game_event)
+			session_deleted,			// A session has been removed from a game. (m_game_event)
 			json_done_reading,			// We finished parsing the json file.
 			new_current_game_selected,	// A game has been selected via right click menu to be the current one. (m_game_event)
 			current_game_changed,		// The confirmation of the new current game selection.
-			game_estimate_changed,		// The estimated of a game changed.
+			game_estimate_changed,		// The estimated of a game changed. (m_game_event)
 			game_list_generated,		// A new game list has just been generated by the list creator (m_game_event)
+			game_moved,					// A game has been dragged to another position of the list. (m_game_event)
+			game_inserted,				// A new game has been requested to be inserted in the list, its description is the inserted game of m_game. (m_game_event)
 			COUNT
 		};
 
@@ -24,6 +28,11 @@ namespace SplitsMgr
 			Games*		m_games{ nullptr };
 			Game*		m_game{ nullptr };
 			bool		m_game_finished{ false };
+			uint32_t	m_session_index{ 0 };	// Index of the session in the game. (session_edited, session_deleted)
+			Split		m_old_session{};		// The session before the change. (session_edited, session_deleted)
+			Split		m_new_session{};		// The session after the change. (session_edited)
+			uint32_t	m_list_slot{ 0 };		// Position of the moved game in the list. (game_moved)
+			uint32_t	m_target_slot{ 0 };		// Position the game is moved or inserted to. (game_moved, game_inserted)
 		};
 
 		Event() = default;
@@ -38,7 +47,7 @@ namespace SplitsMgr
 
 		union
 		{
-			GameEvent m_game_event;		// Game event informations. (session_added, new_current_game_selected, game_list_generated)
+			GameEvent m_game_event;		// Game event informations. (session_added, session_edited, session_deleted, new_current_game_selected, game_estimate_changed, game_list_generated, game_moved, game_inserted)
 		};
 	};
 }
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <thread>
+
+#include <FZN/Tools/Logging.h>
+
+#include "Forecast.h"
+
+
+namespace SplitsMgr
+{
+	/**
+	* @brief SplitMix64, used to derive the seeds of the lanes from the one of their task.
+	**/
+	static uint64_t split_mix( uint64_t& _state )
+	{
+		uint64_t value{ _state += 0x9E3779B97F4A7C15ull };
+		value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+		value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBull;
+		return value ^ ( value >> 31 );
+	}
+
+	Forecaster::~Forecaster()
+	{
+		cancel();
+	}
+
+	void Forecaster::start( const SessionTable& _sessions, Utils::DayNumber _today, SplitTime _game_remaining, SplitTime _list_remaining )
+	{
+		if( _sessions.has_dates() == false || Utils::is_day_valid( _today ) == false )
+		{
+			cancel();
+			m_has_results = false;
+			return;
+		}
+
+		// Every day since the first session is a possible future day, the ones without sessions and the ones after the last session included.
+		const Utils::DayNumber first_day{ _sessions.get_first_day() };
+		const Utils::DayNumber last_day{ std::max( _sessions.get_last_day(), _today - 1 ) };
+		const std::span< const uint32_t > day_seconds{ _sessions.get_day_seconds() };
+
+		auto to_seconds = []( SplitTime _time ) -> uint64_t { return _time > SplitTime{} ? static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::seconds >( _time ).count() ) : 0; };
+
+		const uint64_t game_target{ to_seconds( _game_remaining ) };
+		const uint64_t list_target{ std::max( to_seconds( _list_remaining ), game_target ) };
+
+		// Most refreshes of the stats don't change anything the trials depend on, the running or finished forecast is kept.
+		if( _has_same_inputs( day_seconds, first_day, last_day, _today, game_target, list_target ) )
+			return;
+
+		cancel();
+
+		m_simulation.m_history.assign( static_cast< size_t >( last_day - first_day ) + 1, 0 );
+		std::ranges::copy( day_seconds, m_simulation.m_history.begin() );
+
+		if( std::ranges::all_of( m_simulation.m_history, []( uint32_t _seconds ) { return _seconds == 0; } ) )
+		{
+			m_has_results = false;
+			return;
+		}
+
+		m_simulation.m_game_target = game_target;
+		m_simulation.m_list_target = list_target;
+		m_simulation.m_game_days.resize( nb_trials );
+		m_simulation.m_list_days.resize( nb_trials );
+		m_simulation.m_cancelled = false;
+		m_start_day = _today;
+		m_history_first_day = first_day;
+
+		// Groups of lanes are split evenly between the tasks, the seeds only depend on the day so refreshing the stats doesn't make the dates flicker.
+		const uint32_t nb_tasks{ std::max( std::thread::hardware_concurrency(), 1u ) };
+		const uint32_t nb_groups{ nb_trials / nb_lanes };
+		uint64_t seed{ static_cast< uint64_t >( _today ) };
+
+		for( uint32_t task{ 0 }; task < nb_tasks; ++task )
+		{
+			const uint32_t begin{ nb_groups * task / nb_tasks * nb_lanes };
+			const uint32_t end{ nb_groups * ( task + 1 ) / nb_tasks * nb_lanes };
+
+			if( begin < end )
+				m_tasks.push_back( std::async( std::launch::async, &Forecaster::_simulate, std::ref( m_simulation ), begin, end, split_mix( seed ) ) );
+		}
+
+		FZN_DBLOG( "Forecasting %u trials on %u tasks over %u days of history...", nb_trials, static_cast< uint32_t >( m_tasks.size() ), static_cast< uint32_t >( m_simulation.m_history.size() ) );
+	}
+
+	void Forecaster::cancel()
+	{
+		if( m_tasks.empty() )
+			return;
+
+		m_simulation.m_cancelled = true;
+
+		for( std::future< void >& task : m_tasks )
+			task.wait();
+
+		m_tasks.clear();
+	}
+
+	void Forecaster::update()
+	{
+		if( m_tasks.empty() )
+			return;
+
+		for( const std::future< void >& task : m_tasks )
+		{
+			if( task.wait_for( std::chrono::seconds{ 0 } ) != std::future_status::ready )
+				return;
+		}
+
+		m_tasks.clear();
+
+		m_game_forecast = _get_percentiles( m_simulation.m_game_days, m_start_day );
+		m_list_forecast = _get_percentiles( m_simulation.m_list_days, m_start_day );
+		m_has_results = true;
+	}
+
+	bool Forecaster::_has_same_inputs( std::span< const uint32_t > _day_seconds, Utils::DayNumber _first_day, Utils::DayNumber _last_day, Utils::DayNumber _today, uint64_t _game_target, uint64_t _list_target ) const
+	{
+		if( is_running() == false && m_has_results == false )
+			return false;
+
+		if( _today != m_start_day || _first_day != m_history_first_day || _game_target != m_simulation.m_game_target || _list_target != m_simulation.m_list_target )
+			return false;
+
+		const std::vector< uint32_t >& history{ m_simulation.m_history };
+
+		if( history.size() != static_cast< size_t >( _last_day - _first_day ) + 1 || history.size() < _day_seconds.size() )
+			return false;
+
+		// The tasks only read the history, it can be compared while they run.
+		return std::ranges::equal( _day_seconds, std::span{ history }.first( _day_seconds.size() ) )
+			&& std::all_of( history.begin() + _day_seconds.size(), history.end(), []( uint32_t _seconds ) { return _seconds == 0; } );
+	}
+
+	void Forecaster::_simulate( Simulation& _simulation, uint32_t _begin, uint32_t _end, uint64_t _seed )
+	{
+		const uint32_t* history{ _simulation.m_history.data() };
+		const uint64_t nb_history_days{ _simulation.m_history.size() };
+		const uint64_t game_target{ _simulation.m_game_target };
+		const uint64_t list_target{ _simulation.m_list_target };
+
+		for( uint32_t first_trial{ _begin }; first_trial < _end; first_trial += nb_lanes )
+		{
+			if( _simulation.m_cancelled.load( std::memory_order_relaxed ) )
+				return;
+
+			uint32_t states[ nb_lanes ]{};
+			uint64_t played[ nb_lanes ]{};
+			uint32_t game_days[ nb_lanes ]{};
+			uint32_t list_days[ nb_lanes ]{};
+
+			for( uint32_t lane{ 0 }; lane < nb_lanes; ++lane )
+				states[ lane ] = static_cast< uint32_t >( split_mix( _seed ) ) | 1u;
+
+			for( uint32_t day{ 0 }; day < max_days; ++day )
+			{
+				uint32_t nb_running{ 0 };
+
+				// Finished trials keep drawing days but don't count them anymore, so the lanes of a group all run the same steps.
+				for( uint32_t lane{ 0 }; lane < nb_lanes; ++lane )
+				{
+					uint32_t state{ states[ lane ] };
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					states[ lane ] = state;
+
+					const uint32_t running{ played[ lane ] < list_target };
+					game_days[ lane ] += played[ lane ] < game_target;
+					list_days[ lane ] += running;
+					nb_running += running;
+
+					// Maps the random value on the history without a division.
+					played[ lane ] += history[ ( static_cast< uint64_t >( state ) * nb_history_days ) >> 32 ];
+				}
+
+				if( nb_running == 0 )
+					break;
+			}
+
+			std::ranges::copy( game_days, _simulation.m_game_days.begin() + first_trial );
+			std::ranges::copy( list_days, _simulation.m_list_days.begin() + first_trial );
+		}
+	}
+
+	Forecaster::Percentiles Forecaster::_get_percentiles( std::vector< uint32_t >& _days, Utils::DayNumber _start_day )
+	{
+		Percentiles percentiles{ .m_start_day = _start_day };
+
+		if( _days.empty() )
+			return percentiles;
+
+		// The trials count the days they played on, the first one being the start day.
+		auto get_percentile = [ &_days ]( size_t _percent )
+		{
+			const auto nth{ _days.begin() + ( _days.size() - 1 ) * _percent / 100 };
+			std::ranges::nth_element( _days, nth );
+
+			return *nth > 0 ? *nth - 1 : 0u;
+		};
+
+		percentiles.m_p10 = get_percentile( 10 );
+		percentiles.m_p50 = get_percentile( 50 );
+		percentiles.m_p90 = get_percentile( 90 );
+
+		return percentiles;
+	}
+}
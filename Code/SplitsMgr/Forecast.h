@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <span>
+#include <vector>
+
+#include "Game.h"
+#include "SessionTable.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Predict the end dates of the current game and of the list by simulating possible futures.
+	* Each simulated day draws the play time of a random day of the history, days without sessions included, until the remaining time is played.
+	* The trials are spread over tasks running in the background, the results are picked up once they're all done without blocking the frame.
+	************************************************************************/
+	class Forecaster
+	{
+	public:
+		static constexpr uint32_t nb_trials{ 32768 };
+		static constexpr uint32_t nb_lanes{ 8 };				// Trials simulated side by side in the inner loop.
+		static constexpr uint32_t max_days{ 365 * 100 };		// Trials still going after that are stopped, the history barely has any play time.
+
+		/**
+		* @brief Number of days from the day of the forecast to the end, for 10, 50 and 90 percent of the trials.
+		**/
+		struct Percentiles
+		{
+			Utils::DayNumber get_day( uint32_t _nb_days ) const	{ return Utils::is_day_valid( m_start_day ) ? Utils::add_days_to_date( m_start_day, _nb_days ) : Utils::no_day; }
+
+			Utils::DayNumber	m_start_day{ Utils::no_day };
+			uint32_t			m_p10{ 0 };
+			uint32_t			m_p50{ 0 };
+			uint32_t			m_p90{ 0 };
+		};
+
+		Forecaster() = default;
+		~Forecaster();
+		Forecaster( const Forecaster& ) = delete;
+		Forecaster& operator=( const Forecaster& ) = delete;
+
+		/**
+		* @brief Start a new forecast, the one still running is cancelled. Nothing is done if the inputs are the same as the ones of the current forecast.
+		* @param _sessions The sessions table, its daily totals are copied as the history to draw from.
+		* @param _today The first simulated day.
+		* @param _game_remaining Time left to play on the current game.
+		* @param _list_remaining Time left to play on the whole list, current game included.
+		**/
+		void start( const SessionTable& _sessions, Utils::DayNumber _today, SplitTime _game_remaining, SplitTime _list_remaining );
+		/**
+		* @brief Stop the running tasks. They check it between groups of trials so it only waits for the groups being simulated.
+		**/
+		void cancel();
+		/**
+		* @brief Check if the tasks are done and compute the percentiles if they are. Called each frame, it never waits for them.
+		**/
+		void update();
+
+		bool				is_running() const			{ return m_tasks.empty() == false; }
+		bool				has_results() const			{ return m_has_results; }
+		const Percentiles&	get_game_forecast() const	{ return m_game_forecast; }
+		const Percentiles&	get_list_forecast() const	{ return m_list_forecast; }
+
+	private:
+		/**
+		* @brief Everything the tasks work on. Kept between forecasts so starting a new one doesn't allocate once the history is known.
+		**/
+		struct Simulation
+		{
+			std::vector< uint32_t >	m_history;				// Played seconds of every day from the first session to today.
+			uint64_t				m_game_target{ 0 };		// Seconds to play to finish the current game.
+			uint64_t				m_list_target{ 0 };		// Seconds to play to finish the list.
+			std::vector< uint32_t >	m_game_days;			// Number of days each trial took to finish the current game.
+			std::vector< uint32_t >	m_list_days;			// Number of days each trial took to finish the list.
+			std::atomic< bool >		m_cancelled{ false };
+		};
+
+		/**
+		* @brief True if the running or finished forecast has been started with the same history, day and targets.
+		**/
+		bool _has_same_inputs( std::span< const uint32_t > _day_seconds, Utils::DayNumber _first_day, Utils::DayNumber _last_day, Utils::DayNumber _today, uint64_t _game_target, uint64_t _list_target ) const;
+		/**
+		* @brief Run the trials in [_begin, _end[ by groups of nb_lanes.
+		**/
+		static void _simulate( Simulation& _simulation, uint32_t _begin, uint32_t _end, uint64_t _seed );
+		static Percentiles _get_percentiles( std::vector< uint32_t >& _days, Utils::DayNumber _start_day );
+
+		Simulation							m_simulation;
+		std::vector< std::future< void > >	m_tasks;
+		Utils::DayNumber					m_start_day{ Utils::no_day };
+		Utils::DayNumber					m_history_first_day{ Utils::no_day };
+
+		bool			m_has_results{ false };
+		Percentiles		m_game_forecast{};
+		Percentiles		m_list_forecast{};
+	};
+}
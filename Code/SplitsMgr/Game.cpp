@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <regex>
 #include <format>
 
@@ -13,6 +14,8 @@
 
 #include "Event.h"
 #include "Game.h"
+#include "ListIndex.h"
+#include "Reduction.h"
 #include "SplitsManagerApp.h"
 
 
@@ -26,33 +29,60 @@ namespace SplitsMgr
 	static constexpr ImVec4		frame_bg_current_game		{ 0.58f, 0.43f, 0.03f, 1.f };
 
 
-	static void display_split_infos( const Split& _split, Options::DateFormat _date_format )
+	/**
+	* @return True if the row has been right clicked.
+	**/
+	static bool display_split_infos( const Split& _split, uint32_t _session_index, uint32_t _split_index, const SplitTime& _run_time, Options::DateFormat _date_format )
 	{
 		ImGui::TableNextRow();
 		ImGui::TableSetColumnIndex( 0 );
 
-		ImGui::Text( "sess. %u (%u)", _split.m_session_index, _split.m_split_index );
+		Utils::ShortStr session_label{};
+		snprintf( session_label.m_buffer.data(), session_label.m_buffer.size(), "sess. %u (%u)", _session_index, _split_index );
 
-		if( Utils::is_date_valid( _split.m_date ) )
+		ImGui::Selectable( session_label.c_str(), false, ImGuiSelectableFlags_SpanAllColumns );
+		const bool right_clicked{ ImGui::IsItemClicked( ImGuiMouseButton_Right ) };
+
+		if( _split.m_day != Split::no_date )
 		{
 			ImGui::TableSetColumnIndex( 1 );
-			ImGui::Text( Utils::date_to_str( _split.m_date, _date_format ).c_str() );
+			ImGui::TextUnformatted( Utils::format_date( _split.m_day, _date_format ).c_str() );
 		}
 
 		ImGui::TableSetColumnIndex( 2 );
-		ImGui::Text( Utils::time_to_str( _split.m_segment_time ).c_str() );
+		ImGui::TextUnformatted( Utils::format_time( _split.get_segment_time() ).c_str() );
 
 		ImGui::TableSetColumnIndex( 3 );
-		ImGui::Text( Utils::time_to_str( _split.m_run_time ).c_str() );
+		ImGui::TextUnformatted( Utils::format_time( _run_time ).c_str() );
+
+		return right_clicked;
+	}
+
+	Game::Game( std::pmr::memory_resource* _resource )
+		: m_splits( _resource )
+		, m_session_sketch( _resource )
+		, m_streaks( _resource )
+	{
 	}
 
 	Game::Game( const Desc& _desc, Utils::ParsingInfos& _parsing_infos )
+		: m_splits( _parsing_infos.m_resource )
+		, m_session_sketch( _parsing_infos.m_resource )
+		, m_streaks( _parsing_infos.m_resource )
 	{
 		m_name = _desc.m_name;
 		m_state = _desc.m_state;
 		m_estimation = _desc.m_estimation;
+		m_first_split_index = _parsing_infos.m_split_index;
+		m_run_time_start = _parsing_infos.m_total_time;
 
-		m_splits.push_back( { _parsing_infos.m_split_index, 1, _parsing_infos.m_total_time, _desc.m_played } );
+		if( Split::is_time_valid( _desc.m_played ) )
+		{
+			Split played_split{};
+			played_split.set_segment_time( _desc.m_played );
+			m_splits.push_back( played_split );
+			m_session_sketch.add( played_split.m_seconds );
+		}
 
 		_refresh_game_time();
 
@@ -60,8 +90,6 @@ namespace SplitsMgr
 			++_parsing_infos.m_split_index;
 
 		_parsing_infos.m_total_time += m_played;
-
-		_compute_game_stats();
 	}
 
 	void Game::display()
@@ -74,16 +102,41 @@ namespace SplitsMgr
 
 		const bool header_open = ImGui::CollapsingHeader( m_name.c_str(), is_current() ? ImGuiTreeNodeFlags_DefaultOpen : 0 );
 		const bool header_hovered = ImGui::IsItemHovered();
+
+		// Games of a list can be reordered by dragging their header on the one of the position they should take.
+		if( m_list_index != nullptr )
+		{
+			if( ImGui::BeginDragDropSource() )
+			{
+				ImGui::SetDragDropPayload( "game_slot", &m_list_slot, sizeof( m_list_slot ) );
+				ImGui::TextUnformatted( m_name.c_str() );
+				ImGui::EndDragDropSource();
+			}
+
+			if( ImGui::BeginDragDropTarget() )
+			{
+				if( const ImGuiPayload* payload{ ImGui::AcceptDragDropPayload( "game_slot" ) } )
+				{
+					Event* game_event = new Event( Event::Type::game_moved );
+					game_event->m_game_event.m_list_slot = *static_cast< const uint32_t* >( payload->Data );
+					game_event->m_game_event.m_target_slot = m_list_slot;
+
+					g_pFZN_Core->PushEvent( game_event );
+				}
+
+				ImGui::EndDragDropTarget();
+			}
+		}
 		
 		_right_click( game_state );
 
 		if( Utils::is_time_valid( m_played ) )
 		{
-			std::string game_time{ Utils::time_to_str( m_played ) };
+			const Utils::ShortStr game_time{ Utils::format_time( m_played ) };
 			const float game_time_width{ ImGui::CalcTextSize( game_time.c_str() ).x };
 
 			ImGui::SameLine( ImGui::GetContentRegionAvail().x - ImGui::GetStyle().FramePadding.x - game_time_width );
-			ImGui::Text( game_time.c_str() );
+			ImGui::TextUnformatted( game_time.c_str() );
 		}
 
 		_pop_state_colors( game_state );
@@ -102,13 +155,25 @@ namespace SplitsMgr
 			if( ImGui::BeginTable( "splits_infos", 4 ) )
 			{
 				// Put here for better spacing in the app.
-				if( has_sessions() )
+				SplitTime run_time{ get_run_time_start() };
+				const uint32_t first_split_index{ get_first_split_index() };
+
+				for( uint32_t split_index{ 0 }; split_index < m_splits.size(); ++split_index )
 				{
-					for( Split& split : m_splits )
-						display_split_infos( split, options.m_date_format );
+					run_time += m_splits[ split_index ].get_segment_time();
+
+					if( display_split_infos( m_splits[ split_index ], split_index + 1, first_split_index + split_index, run_time, options.m_date_format ) )
+					{
+						m_edited_session = split_index;
+						m_edited_session_time = Utils::time_to_str( m_splits[ split_index ].get_segment_time() );
+						m_edited_session_date = Utils::is_day_valid( m_splits[ split_index ].m_day ) ? Utils::date_to_str( m_splits[ split_index ].get_date() ) : std::string{};
+						ImGui::OpenPopup( "session_popup" );
+					}
 				}
 				ImGui::EndTable();
 			}
+
+			_session_popup();
 			
 			if( are_sessions_over() == false )
 			{
@@ -166,24 +231,21 @@ namespace SplitsMgr
 		if( m_finished_game_popup == false )
 		{
 			m_finished_game_popup = true;
-			_compute_game_stats();
-			compute_end_date();
 			ImGui::OpenPopup( popup_name.c_str() );
 		}
 
 		if( m_finished_game_popup )
 		{
+			// A 0 height fits the popup to its content every frame, the stats table is often higher than the cover.
 			ImVec2 popup_size{};
 			ImGui::SetWindowFontScale( 2.f );
 			const ImVec2 game_name_size{ ImGui::CalcTextSize( m_name.c_str() ) };
-			popup_size.y = ImGui::GetTextLineHeightWithSpacing() + ImGui::GetStyle().ItemSpacing.y;
 			ImGui::SetWindowFontScale( 1.f );
 
 			popup_size.x = std::max( 356.f, game_name_size.x ) + ImGui::GetStyle().WindowPadding.x * 2.f;
-			popup_size.y += Utils::game_cover_size.y + ImGui::GetStyle().WindowPadding.y * 2.f + ImGui::GetFrameHeightWithSpacing() + ImGui::GetStyle().ItemSpacing.y;
 			sf::Vector2u window_size = g_pFZN_WindowMgr->GetWindowSize();
 
-			ImGui::SetNextWindowPos( { window_size.x * 0.5f - popup_size.x * 0.5f, window_size.y * 0.5f - popup_size.y * 0.5f }, ImGuiCond_Appearing );
+			ImGui::SetNextWindowPos( { window_size.x * 0.5f, window_size.y * 0.5f }, ImGuiCond_Appearing, { 0.5f, 0.5f } );
 			ImGui::SetNextWindowSize( popup_size );
 
 			if( ImGui::BeginPopupModal( popup_name.c_str(), &m_finished_game_popup, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize ) )
@@ -213,34 +275,51 @@ namespace SplitsMgr
 	void Game::display_end_date_predition()
 	{
 		// If there is no valid begin date in the global stats, there won't be in the game either sor there is no need to go further.
-		if( Utils::is_date_valid( g_splits_app->get_splits_manager().get_stats().get_begin_date() ) == false )
+		if( Utils::is_day_valid( g_splits_app->get_splits_manager().get_stats().get_begin_day() ) == false )
 			return;
 
 		const Options::OptionsDatas& options{ g_splits_app->get_options().get_options_datas() };
+		const Stats& stats{ _get_stats() };
 
 		ImGui::Separator();
 		
 		if( has_sessions() )
 		{
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "First session:", "%s", Utils::date_to_str( m_stats.m_begin_date, options.m_date_format ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s (%u day(s))", Utils::time_to_str( m_stats.m_avg_session_played_day ).c_str(), m_stats.m_played_days );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s (%u day(s))", Utils::time_to_str( m_stats.m_avg_session_day ).c_str(), m_stats.m_days_since_start );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Remaining:", "%u day(s) | %u played day(s) | %u session(s)", m_stats.m_remaining_days, m_stats.m_remaining_played_days, m_stats.m_remaining_sessions );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::date_to_str( m_stats.m_end_date, options.m_date_format ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "First session:", "%s", Utils::format_date( get_begin_day(), options.m_date_format ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s (%u day(s))", Utils::format_time( stats.m_avg_session_played_day ).c_str(), stats.m_played_days );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s (%u day(s))", Utils::format_time( stats.m_avg_session_day ).c_str(), stats.m_days_since_start );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Remaining:", "%u day(s) | %u played day(s) | %u session(s)", stats.m_remaining_days, stats.m_remaining_played_days, stats.m_remaining_sessions );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::format_date( stats.m_end_day, options.m_date_format ).c_str() );
+			_display_forecast( options );
 		}
 		else
 		{
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::gray, "First session:", "%s", Utils::date_to_str( Utils::today(), options.m_date_format ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::gray, "First session:", "%s", Utils::format_date( Utils::today(), options.m_date_format ).c_str() );
 			ImGui::SameLine();
 			ImGui_fzn::helper_simple_tooltip( "This game doesn't have any session yet \nThe prediction is based on global stats and the end date is calculated from the current day." );
 
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s", Utils::time_to_str( m_stats.m_avg_session_played_day ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s", Utils::time_to_str( m_stats.m_avg_session_day ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Remaining:", "%u day(s) | %u played day(s) | %u session(s)", m_stats.m_remaining_days, m_stats.m_remaining_played_days, m_stats.m_remaining_sessions );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::date_to_str( m_stats.m_end_date, options.m_date_format ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s", Utils::format_time( stats.m_avg_session_played_day ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s", Utils::format_time( stats.m_avg_session_day ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Remaining:", "%u day(s) | %u played day(s) | %u session(s)", stats.m_remaining_days, stats.m_remaining_played_days, stats.m_remaining_sessions );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::format_date( stats.m_end_day, options.m_date_format ).c_str() );
+			_display_forecast( options );
 		}
 	}
 
+	void Game::_display_forecast( const Options::OptionsDatas& _options )
+	{
+		const Forecaster& forecaster{ g_splits_app->get_splits_manager().get_stats().get_forecaster() };
+
+		// The forecast is made for the current game of the loaded list, not the ones being created.
+		if( m_list_index == nullptr || is_current() == false || forecaster.has_results() == false )
+			return;
+
+		const Forecaster::Percentiles& forecast{ forecaster.get_game_forecast() };
+		ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Forecast last day:", "%s / %s / %s", Utils::format_date( forecast.get_day( forecast.m_p10 ), _options.m_date_format ).c_str(), Utils::format_date( forecast.get_day( forecast.m_p50 ), _options.m_date_format ).c_str(), Utils::format_date( forecast.get_day( forecast.m_p90 ), _options.m_date_format ).c_str() );
+		ImGui::SameLine();
+		ImGui_fzn::helper_simple_tooltip( "Last day reached by 10%, 50% and 90% of simulated futures, each day playing as much as a random day since the first session." );
+	}
+
 	void Game::state_combo_box( Game::State& _state )
 	{
 		static uint32_t state_none_id{ static_cast<uint32_t>( Game::State::none ) };
@@ -266,21 +345,14 @@ namespace SplitsMgr
 
 	bool Game::contains_split_index( uint32_t _index ) const
 	{
-		if( m_splits.empty() )
-			return false;
+		const uint32_t first_split_index{ get_first_split_index() };
 
-		return m_splits.front().m_split_index <= _index && m_splits.back().m_split_index >= _index;
+		return _index >= first_split_index && _index < first_split_index + m_splits.size();
 	}
 
 	bool Game::has_sessions() const
 	{
-		if( m_splits.empty() )
-			return false;
-
-		if( m_splits.size() == 1 && Utils::is_time_valid( m_splits.back().m_segment_time ) == false )
-			return false;
-
-		return true;
+		return m_splits.empty() == false;
 	}
 
 	const char* Game::get_state_str() const
@@ -325,17 +397,30 @@ namespace SplitsMgr
 		return State::none;
 	}
 
+	uint32_t Game::get_first_split_index() const
+	{
+		return m_list_index != nullptr ? m_list_index->get_first_split_index( m_list_slot ) : m_first_split_index;
+	}
+
+	SplitTime Game::get_run_time_start() const
+	{
+		return m_list_index != nullptr ? m_list_index->get_run_time_start( m_list_slot ) : m_run_time_start;
+	}
+
+	void Game::set_list_slot( const ListIndex* _list_index, uint32_t _slot )
+	{
+		m_list_index = _list_index;
+		m_list_slot = _slot;
+	}
+
 	SplitTime Game::get_run_time() const
 	{
-		SplitTime last_valid_time{};
+		SplitTime run_time{ get_run_time_start() };
 
 		for( const Split& split : m_splits )
-		{
-			if( Utils::is_time_valid( split.m_run_time ) )
-				last_valid_time = split.m_run_time;
-		}
+			run_time += split.get_segment_time();
 
-		return last_valid_time;
+		return run_time;
 	}
 
 	SplitTime Game::get_played() const
@@ -345,111 +430,133 @@ namespace SplitsMgr
 
 	SplitTime Game::get_last_valid_segment_time() const
 	{
-		SplitTime last_segment{};
-
-		for( const Split& split : m_splits )
-		{
-			if( Utils::is_time_valid( split.m_segment_time ) )
-				last_segment = split.m_segment_time;
-		}
+		if( m_splits.empty() )
+			return {};
 
-		return last_segment;
+		return m_splits.back().get_segment_time();
 	}
 
 	/**
 	* @brief Add a session to the game, from timer or manual add. Run time will be determined thanks to the game splits themselves.
 	* @param _time The time of the session we want to add.
-	* @param _date The date of the session.
+	* @param _day The day of the session.
 	* @param _state The new state of the game.
 	**/
-	void Game::add_session( const SplitTime& _time, const SplitDate& _date, State _state )
+	void Game::add_session( const SplitTime& _time, Utils::DayNumber _day, State _state )
 	{
-		if( m_splits.empty() || Utils::is_time_valid( _time ) == false )
+		if( Split::is_time_valid( _time ) == false )
 			return;
 
-		// If there is only one split that has no segment time, that means the session we add is the first one on the game and we want to update the existing split.
-		// This split was created when reading the json and contains the necessary informations to add a new session (run time and split index)
-		if( has_sessions() == false )
-		{
-			Split& last_split{ m_splits.back() };
+		// Split index and run time of the new session come from its position in the game, only its time and date are stored.
+		Split new_split{};
+		new_split.set_segment_time( _time );
+		new_split.m_day = _day;
 
-			last_split.m_run_time += _time;
-			last_split.m_segment_time = _time;
-			last_split.m_date = _date;
+		m_splits.push_back( new_split );
+		m_session_sketch.add( new_split.m_seconds );
+		m_streaks.add_sessions( new_split.m_day );
 
-			m_stats.m_begin_date = last_split.m_date;
-		}
-		// If there are more than one split, sessions have already been added to the game and we can use their informations for the one we want to add.
-		else
+		m_state = _state;
+
+		_refresh_game_time();
+	}
+
+	/**
+	* @brief Add several sessions at once, the game time is only refreshed after the last one.
+	* @param _splits The sessions to add, in chronological order.
+	* @param _state The new state of the game.
+	**/
+	void Game::add_sessions( std::span< const Split > _splits, State _state )
+	{
+		const size_t previous_nb_splits{ m_splits.size() };
+		m_splits.reserve( previous_nb_splits + _splits.size() );
+
+		for( const Split& split : _splits )
 		{
-			const Split& last_split{ m_splits.back() };
-			
-			Split new_split{ last_split.m_split_index + 1, last_split.m_session_index + 1 };
+			if( split.m_seconds == 0 )
+				continue;
 
-			new_split.m_run_time = last_split.m_run_time + _time;
-			new_split.m_segment_time = _time;
-			new_split.m_date = _date;
+			// Imported days are checked like the ones typed in or read from a file.
+			Split& new_split{ m_splits.emplace_back( split ) };
+			new_split.m_day = Utils::check_session_day( split.m_day );
 
-			m_splits.push_back( std::move( new_split ) );
+			m_session_sketch.add( new_split.m_seconds );
+			m_streaks.add_sessions( new_split.m_day );
 		}
 
-		m_state = _state;
+		if( m_splits.size() == previous_nb_splits )
+			return;
 
+		m_state = _state;
 		_refresh_game_time();
-		_compute_game_stats();
+	}
 
-		if( are_sessions_over() == false )
-			compute_end_date();
+	void Game::edit_session( uint32_t _index, const SplitTime& _time, Utils::DayNumber _day )
+	{
+		if( _index >= m_splits.size() || Split::is_time_valid( _time ) == false )
+			return;
+
+		Split& split{ m_splits[ _index ] };
+
+		m_played -= split.get_segment_time();
+		m_session_sketch.remove( split.m_seconds );
+		m_streaks.remove_session( split.m_day );
+
+		split.set_segment_time( _time );
+		split.m_day = _day;
+
+		m_played += split.get_segment_time();
+		m_session_sketch.add( split.m_seconds );
+		m_streaks.add_sessions( split.m_day );
+
+		_refresh_delta();
 	}
 
-	/**
-	* @brief Update game datas by incrementing its splits indexes and adding a time to their run time.
-	* @param _delta_to_add The time delta that has been added on a game before this one that we need to add.
-	**/
-	void Game::update_data( const SplitTime& _delta_to_add )
+	void Game::delete_session( uint32_t _index )
 	{
-		for( Split& split : m_splits )
-		{
-			++split.m_split_index;
-			split.m_run_time += _delta_to_add;
-		}
+		if( _index >= m_splits.size() )
+			return;
+
+		m_played -= m_splits[ _index ].get_segment_time();
+		m_session_sketch.remove( m_splits[ _index ].m_seconds );
+		m_streaks.remove_session( m_splits[ _index ].m_day );
+		m_splits.erase( m_splits.begin() + _index );
 
-		if( m_state != State::none )
-			m_played += m_delta;
+		_refresh_delta();
 	}
 
 	/**
 	* @brief Calculate at which date the game could be finished, either by using its stats if it has any sessions, or the global stats compiled from all the previous games.
 	**/
-	void Game::compute_end_date()
+	void Game::_compute_end_date()
 	{
 		const SplitTime played{ m_played };
 		const SplitTime remaining_time{ m_estimation - played };
-		std::vector< ComboStat > played_days;
-
-		if( Utils::is_date_valid( m_stats.m_begin_date ) )
+		if( Utils::is_day_valid( get_begin_day() ) )
 		{
+			std::vector< Utils::DayNumber > played_days;
+			played_days.reserve( m_splits.size() );
+
 			for( const Split& split : m_splits )
 			{
-				if( Utils::is_date_valid( split.m_date ) == false )
-					continue;
-
-				if( std::ranges::find( played_days, split.m_date, &ComboStat::m_date ) == played_days.end() )
-				{
-					played_days.push_back( { .m_date = split.m_date } );
-				}
+				if( split.m_day != Split::no_date )
+					played_days.push_back( split.m_day );
 			}
 
+			std::ranges::sort( played_days );
+			const auto [ first_duplicate, last_duplicate ] = std::ranges::unique( played_days );
+			played_days.erase( first_duplicate, last_duplicate );
+
 			if( played_days.empty() == false )
 			{
 				m_stats.m_played_days = played_days.size();
 				m_stats.m_avg_session_played_day = played / m_stats.m_played_days;
-				m_stats.m_remaining_played_days = remaining_time / m_stats.m_avg_session_played_day;
+				m_stats.m_remaining_played_days = static_cast< uint32_t >( remaining_time / m_stats.m_avg_session_played_day );
 
 				m_stats.m_avg_sessions_days = m_splits.size() / static_cast<float>( m_stats.m_played_days );
 			}
 
-			m_stats.m_days_since_start = Utils::days_between_dates( m_stats.m_begin_date, Utils::today() );
+			m_stats.m_days_since_start = Utils::days_between_dates( get_begin_day(), Utils::today() );
 
 			if( m_stats.m_days_since_start > 0 )
 				m_stats.m_avg_session_day = played / m_stats.m_days_since_start;
@@ -462,23 +569,28 @@ namespace SplitsMgr
 			const auto& global_stats = g_splits_app->get_splits_manager().get_stats();
 
 			// If there is no valid begin date in the global stat, nothing will be able to be computed so there's no need continuing.
-			if( Utils::is_date_valid( global_stats.get_begin_date() ) == false )
+			if( Utils::is_day_valid( global_stats.get_begin_day() ) == false )
 				return;
 
 			m_stats.m_avg_session_day = global_stats.get_avg_session_day();
 			m_stats.m_avg_session_played_day = global_stats.get_avg_session_played_day();
 
 			if( Utils::is_time_valid( m_stats.m_avg_session_played_day ) )
-				m_stats.m_remaining_played_days = remaining_time / m_stats.m_avg_session_played_day;
+				m_stats.m_remaining_played_days = static_cast< uint32_t >( remaining_time / m_stats.m_avg_session_played_day );
 
 			m_stats.m_avg_sessions_days = global_stats.get_avg_sessions_days();
 		}
 
-		if( Utils::is_time_valid( m_stats.m_avg_session_day ) )
-			m_stats.m_remaining_days = remaining_time / m_stats.m_avg_session_day;
+		const RateModel& rates{ g_splits_app->get_splits_manager().get_rate_model() };
+
+		// The weekday and recent play rates of the whole list give the remaining days, the averages of the game are only displayed.
+		if( rates.is_valid() )
+			m_stats.m_remaining_days = rates.get_remaining_days( Utils::today(), remaining_time );
+		else if( Utils::is_time_valid( m_stats.m_avg_session_day ) )
+			m_stats.m_remaining_days = static_cast< uint32_t >( remaining_time / m_stats.m_avg_session_day );
 
 		m_stats.m_remaining_sessions = ceil( m_stats.m_remaining_played_days * m_stats.m_avg_sessions_days );
-		m_stats.m_end_date = Utils::add_days_to_date( Utils::today(), m_stats.m_remaining_days );
+		m_stats.m_end_day = Utils::add_days_to_date( Utils::today(), m_stats.m_remaining_days );
 	}
 
 	/**
@@ -490,7 +602,7 @@ namespace SplitsMgr
 	bool Game::read( const Json::Value& _game, Utils::ParsingInfos& _parsing_infos )
 	{
 		m_name = _game[ "Name" ].asString();
-		m_estimation = Utils::get_time_from_string( _game[ "Estimate" ].asString() );
+		m_estimation = Utils::parse_time( _game[ "Estimate" ].asCString() );
 
 		m_state = get_state_from_str( _game[ "State" ].asString() );
 		m_cover_data = _game[ "Cover" ].asString();
@@ -501,60 +613,57 @@ namespace SplitsMgr
 			m_cover = g_pFZN_DataMgr->load_texture_from_memory( m_name, decoded_data.data(), decoded_data.size() );
 		}
 
-		Json::Value sessions = _game[ "Sessions" ];
+		const Json::Value& sessions = _game[ "Sessions" ];
 
 		m_played = SplitTime{};
+		m_first_split_index = _parsing_infos.m_split_index;
+		m_run_time_start = _parsing_infos.m_total_time;
+
+		// Reserving the exact number of splits (plus the one for the next session) so the arena doesn't keep the intermediate buffers of a growing vector.
+		m_splits.reserve( sessions.size() + 1 );
 
-		for( Json::Value::iterator it_session = sessions.begin(); it_session != sessions.end(); ++it_session )
+		for( const Json::Value& session : sessions )
 		{
-			const Json::Value& session = *it_session;
-			auto session_infos{ fzn::Tools::split( session.asString(), ',' ) };
+			// Sessions are "time, date" strings, they are split in place instead of going through a temporary vector of strings.
+			const std::string_view session_infos{ session.asCString() };
 
 			if( session_infos.empty() )
 				continue;
 
-			Split new_split{ _parsing_infos.m_split_index, m_splits.size() + 1 };
+			Split new_split{};
 
-			new_split.m_segment_time = Utils::get_time_from_string( session_infos.at( 0 ) );
+			const size_t comma{ session_infos.find( ',' ) };
+			const SplitTime segment_time{ Utils::parse_time( session_infos.substr( 0, comma ) ) };
+			new_split.set_segment_time( segment_time );
 
-			if( session_infos.size() > 1 )
+			if( comma != std::string_view::npos )
 			{
-				SplitDate session_date = Utils::get_date_from_string( session_infos.at( 1 ) );
+				std::string_view date_str{ session_infos.substr( comma + 1 ) };
+				date_str.remove_prefix( std::min( date_str.find_first_not_of( ' ' ), date_str.size() ) );
 
-				if( session_date != SplitDate{} )
-					new_split.m_date = session_date;
+				new_split.set_date( Utils::get_date_from_string( date_str ) );
+				new_split.m_day = Utils::check_session_day( new_split.m_day );
 			}
 
-			if( Utils::is_time_valid( new_split.m_segment_time ) == false )
+			if( new_split.m_seconds == 0 )
 				continue;
 
-			_parsing_infos.m_total_time += new_split.m_segment_time;
-			m_played += new_split.m_segment_time;
+			_parsing_infos.m_total_time += new_split.get_segment_time();
+			m_played += new_split.get_segment_time();
 
-			new_split.m_run_time = _parsing_infos.m_total_time;
-
-			if( m_splits.empty() )
-				m_stats.m_begin_date = new_split.m_date;
-
-			m_splits.push_back( std::move( new_split ) );
+			m_splits.push_back( new_split );
+			m_session_sketch.add( new_split.m_seconds );
+			m_streaks.add_sessions( new_split.m_day );
 			++_parsing_infos.m_split_index;
 		}
 
-		if( are_sessions_over() == false && m_splits.empty() )
-		{
-			m_splits.push_back( { _parsing_infos.m_split_index, 1, _parsing_infos.m_total_time } );
-		}
-
 		const SplitTime tmp_delta{ m_played - m_estimation };
 
 		// Update the delta if the game is finished, or the estimate has been exceeded.
 		if( m_state == State::finished || has_sessions() && tmp_delta > std::chrono::seconds{ 0 } )
 			m_delta = tmp_delta;
 
-		if( has_sessions() )
-			_compute_game_stats();
-
-		compute_end_date();
+		_on_data_changed();
 
 		return m_state == State::current;
 	}
@@ -580,13 +689,11 @@ namespace SplitsMgr
 
 		for( uint32_t split_index{ 0 }; split_index < m_splits.size(); ++split_index )
 		{
-			if( Utils::is_time_valid( m_splits[ split_index ].m_segment_time ) == false )
-				return;
-
-			session_infos = Utils::time_to_str( m_splits[ split_index ].m_segment_time ).c_str();
+			const Split& split{ m_splits[ split_index ] };
+			session_infos = Utils::time_to_str( split.get_segment_time() ).c_str();
 
-			if( Utils::is_date_valid( m_splits[ split_index ].m_date ) )
-				session_infos += fzn::Tools::Sprintf( ", %s", Utils::date_to_str( m_splits[ split_index ].m_date ).c_str() );
+			if( split.m_day != Split::no_date )
+				session_infos += fzn::Tools::Sprintf( ", %s", Utils::date_to_str( split.get_date() ).c_str() );
 
 			_game[ "Sessions" ][ split_index ] = session_infos.c_str();
 		}
@@ -604,16 +711,16 @@ namespace SplitsMgr
 
 		m_new_session_time.clear();
 
-		if( Utils::is_time_valid( new_segment_time ) == false )
+		if( Split::is_time_valid( new_segment_time ) == false )
 			return;
 
-		SplitDate segment_date = Utils::get_date_from_string( m_new_session_date );
+		const Utils::DayNumber segment_day{ Utils::check_session_day( Utils::to_day_number( Utils::get_date_from_string( m_new_session_date ) ) ) };
 		m_new_session_date.clear();
 
 		if( m_state == State::current && m_new_session_state == State::playing )
 			m_new_session_state = m_state;
 
-		add_session( new_segment_time, segment_date, m_new_session_state );
+		add_session( new_segment_time, segment_day, m_new_session_state );
 
 		Event* game_event = new Event( Event::Type::session_added );
 		game_event->m_game_event.m_game = this;
@@ -623,45 +730,139 @@ namespace SplitsMgr
 		m_new_session_state = State::playing;
 	}
 
+	void Game::_session_popup()
+	{
+		if( ImGui::BeginPopup( "session_popup" ) == false )
+			return;
+
+		if( m_edited_session >= m_splits.size() )
+		{
+			ImGui::CloseCurrentPopup();
+			ImGui::EndPopup();
+			return;
+		}
+
+		ImGui::Text( "Session %u", m_edited_session + 1 );
+
+		ImGui::PushItemWidth( 80.f );
+		ImGui::InputTextWithHint( "##edited_session_time", "00:00:00", &m_edited_session_time );
+		ImGui::SameLine();
+		ImGui::InputTextWithHint( "##edited_session_date", "yyyy-mm-dd", &m_edited_session_date );
+		ImGui::PopItemWidth();
+
+		const SplitTime edited_time{ Utils::parse_time( m_edited_session_time ) };
+		Event* game_event{ nullptr };
+
+		if( ImGui_fzn::deactivable_button( "Apply", Split::is_time_valid( edited_time ) == false, false, { 80.f, 0.f } ) )
+		{
+			const Split old_session{ m_splits[ m_edited_session ] };
+			edit_session( m_edited_session, edited_time, Utils::check_session_day( Utils::parse_date( m_edited_session_date ) ) );
+
+			game_event = new Event( Event::Type::session_edited );
+			game_event->m_game_event.m_old_session = old_session;
+			game_event->m_game_event.m_new_session = m_splits[ m_edited_session ];
+		}
+
+		ImGui::SameLine();
+
+		if( ImGui::Button( "Delete", { 80.f, 0.f } ) )
+		{
+			const Split old_session{ m_splits[ m_edited_session ] };
+			delete_session( m_edited_session );
+
+			game_event = new Event( Event::Type::session_deleted );
+			game_event->m_game_event.m_old_session = old_session;
+		}
+
+		if( game_event != nullptr )
+		{
+			game_event->m_game_event.m_game = this;
+			game_event->m_game_event.m_session_index = m_edited_session;
+
+			g_pFZN_Core->PushEvent( game_event );
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+
+	void Game::_insert_game_menu()
+	{
+		if( m_list_index == nullptr || ImGui::BeginMenu( "Insert Game" ) == false )
+			return;
+
+		ImGui::SetNextItemWidth( DefaultWidgetSize.x );
+		ImGui::InputTextWithHint( "##inserted_game_name", "Name", &m_inserted_game_name );
+		ImGui::SetNextItemWidth( DefaultWidgetSize.x );
+		ImGui::InputTextWithHint( "##inserted_game_estimate", "Estimate (00:00)", &m_inserted_game_estimate );
+
+		const SplitTime estimate{ Utils::parse_time( m_inserted_game_estimate ) };
+		const bool invalid_game{ m_inserted_game_name.empty() || Utils::is_time_valid( estimate ) == false };
+		uint32_t target_slot{ UINT32_MAX };
+
+		if( ImGui_fzn::deactivable_button( "Above", invalid_game, false, { 72.f, 0.f } ) )
+			target_slot = m_list_slot;
+
+		ImGui::SameLine();
+
+		if( ImGui_fzn::deactivable_button( "Under", invalid_game, false, { 72.f, 0.f } ) )
+			target_slot = m_list_slot + 1;
+
+		if( target_slot != UINT32_MAX )
+		{
+			m_inserted_game = Desc{ m_inserted_game_name, estimate };
+			m_inserted_game_name.clear();
+			m_inserted_game_estimate.clear();
+
+			Event* game_event = new Event( Event::Type::game_inserted );
+			game_event->m_game_event.m_game = this;
+			game_event->m_game_event.m_target_slot = target_slot;
+
+			g_pFZN_Core->PushEvent( game_event );
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndMenu();
+	}
+
 	void Game::_refresh_game_time()
 	{
 		m_played = SplitTime{};
-		m_delta = SplitTime{};
 
-		for( Split& split : m_splits )
-			m_played += split.m_segment_time;
+		for( const Split& split : m_splits )
+			m_played += split.get_segment_time();
 
+		_refresh_delta();
+	}
+
+	void Game::_refresh_delta()
+	{
+		m_delta = SplitTime{};
 		const SplitTime tmp_delta{ m_played - m_estimation };
 
 		// Update the delta if the game is finished, or the estimate has been exceeded.
 		if( m_state == State::finished || m_state != State::none && tmp_delta > std::chrono::seconds{ 0 } )
 			m_delta = tmp_delta;
+
+		_on_data_changed();
 	}
 
 	void Game::_refresh_state()
 	{
-		if( m_state == State::abandonned )
+		// Finished and abandonned games won't recieve new sessions, their state can't change anymore.
+		if( are_sessions_over() )
 			return;
 
-		const State prev_state{ m_state };
 		const Game* current_game{ g_splits_app->get_current_game() };
 
-		// If the last split doesn't have a segment time, it meas the game is still ready to recieve new sessions.
-		// If there is a segment time, it means we don't want to add sessions anymore, and the game is finished.
-		if( Utils::is_time_valid( m_splits.back().m_segment_time ) )
-		{
-			m_state = State::finished;
-			return;
-		}
-
 		if( current_game != nullptr && current_game == this )
 		{
 			m_state = State::current;
 			return;
 		}
 
-		// An ongoing game will have more than one split, as there is always an empty one for its next session in addition to already submitted sessions.
-		if( m_splits.size() > 1 )
+		// An ongoing game already has sessions.
+		if( has_sessions() )
 		{
 			m_state = State::playing;
 			return;
@@ -818,6 +1019,8 @@ namespace SplitsMgr
 				m_cover_data.clear();
 			}
 
+			_insert_game_menu();
+
 			_push_state_colors( _state );
 			ImGui::EndPopup();
 		}
@@ -825,14 +1028,14 @@ namespace SplitsMgr
 
 	void Game::_tooltip()
 	{
+		// Only the width is set, the height follows the cover or the stats table, whichever is higher.
 		ImVec2 popup_size{};
 		const ImVec2 game_name_size{ ImGui::CalcTextSize( m_name.c_str() ) };
 
 		popup_size.x = std::max( 356.f, game_name_size.x ) + ImGui::GetStyle().WindowPadding.x * 2.f;
-		popup_size.y = Utils::game_cover_size.y + ImGui::GetStyle().WindowPadding.y * 2.f + ImGui::GetFrameHeightWithSpacing();
 		sf::Vector2u window_size = g_pFZN_WindowMgr->GetWindowSize();
 
-		ImGui::SetNextWindowPos( { window_size.x * 0.5f - popup_size.x * 0.5f, window_size.y * 0.5f - popup_size.y * 0.5f }, ImGuiCond_Appearing );
+		ImGui::SetNextWindowPos( { window_size.x * 0.5f, window_size.y * 0.5f }, ImGuiCond_Appearing, { 0.5f, 0.5f } );
 		ImGui::SetNextWindowSize( popup_size );
 
 		if( ImGui::BeginTooltip() )
@@ -866,11 +1069,14 @@ namespace SplitsMgr
 			ImGui::Text( "Estimate:");
 			ImGui::SameLine();
 			ImGui::SetNextItemWidth( 70.f );
-			std::string estimate = Utils::time_to_str( m_estimation );
-			if( ImGui::InputText( "##Estimate", &estimate, ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CharsNoBlank ) )
+			Utils::ShortStr estimate{ Utils::format_time( m_estimation ) };
+			if( ImGui::InputText( "##Estimate", estimate.m_buffer.data(), estimate.m_buffer.size(), ImGuiInputTextFlags_EnterReturnsTrue | ImGuiInputTextFlags_CharsNoBlank ) )
 			{
-				m_estimation = Utils::get_time_from_string( estimate );
-				g_pFZN_Core->PushEvent( new Event( Event::Type::game_estimate_changed ) );
+				m_estimation = Utils::get_time_from_string( estimate.c_str() );
+				_on_data_changed();
+				Event* game_event = new Event( Event::Type::game_estimate_changed );
+				game_event->m_game_event.m_game = this;
+				g_pFZN_Core->PushEvent( game_event );
 			}
 			ImGui::TableNextColumn();
 
@@ -880,13 +1086,13 @@ namespace SplitsMgr
 				{
 					ImGui::Text( "Delta:" );
 					ImGui::SameLine();
-					ImGui::Text( Utils::time_to_str( m_delta ).c_str() );
+					ImGui::TextUnformatted( Utils::format_time( m_delta ).c_str() );
 				}
 				else
 				{
 					ImGui::Text( "Delta:" );
 					ImGui::SameLine();
-					ImGui::Text( "+%s", Utils::time_to_str( m_delta ).c_str() );
+					ImGui::Text( "+%s", Utils::format_time( m_delta ).c_str() );
 				}
 			}
 
@@ -923,29 +1129,40 @@ namespace SplitsMgr
 	**/
 	void Game::_compute_game_stats()
 	{
-		m_stats.m_average_session_time = SplitTime{};
-		m_stats.m_longest_sesion = SplitTime{};
-		m_stats.m_shortest_session = Utils::get_time_from_string( "99:59:59" );
+		const Reduction::Summary summary{ Reduction::summarize( std::span< const Split >{ m_splits } ) };
 
-		if( m_splits.empty() )
-			return;
+		m_stats.m_average_session_time = summary.get_average();
+		m_stats.m_longest_sesion = summary.get_max();
+		m_stats.m_shortest_session = summary.get_min();
 
-		for( const Split& split : m_splits )
-		{
-			m_stats.m_average_session_time += split.m_segment_time;
+		m_stats.m_median_session = m_session_sketch.get_quantile( 0.5 );
+		m_stats.m_p90_session = m_session_sketch.get_quantile( 0.9 );
+		m_stats.m_p99_session = m_session_sketch.get_quantile( 0.99 );
 
-			if( m_stats.m_longest_sesion < split.m_segment_time )
-			{
-				m_stats.m_longest_sesion = split.m_segment_time;
-			}
+		m_stats.m_longest_streak = m_streaks.get_longest();
+		m_stats.m_current_streak = m_streaks.get_current( Utils::today() );
+	}
 
-			if( m_stats.m_shortest_session > split.m_segment_time )
-			{
-				m_stats.m_shortest_session = split.m_segment_time;
-			}
-		}
+	/**
+	* @brief Get the game stats, computing them first if they're outdated.
+	**/
+	const Game::Stats& Game::_get_stats()
+	{
+		const auto& global_stats = g_splits_app->get_splits_manager().get_stats();
+		const Utils::DayNumber today{ Utils::today() };
 
-		m_stats.m_average_session_time /= m_splits.size();
+		if( m_stats.m_data_version == m_data_version && m_stats.m_global_version == global_stats.get_version() && m_stats.m_today == today )
+			return m_stats;
+
+		m_stats = Stats{};
+		m_stats.m_data_version = m_data_version;
+		m_stats.m_global_version = global_stats.get_version();
+		m_stats.m_today = today;
+
+		_compute_game_stats();
+		_compute_end_date();
+
+		return m_stats;
 	}
 
 	/**
@@ -957,6 +1174,7 @@ namespace SplitsMgr
 		ImVec2 time_size{};
 		const ImGuiStyle& style{ ImGui::GetStyle() };
 		const float first_column_size{ 140.f };
+		const Stats& stats{ _get_stats() };
 		const float second_column_width{ _window_width - style.WindowPadding.x * 2.f - style.ItemSpacing.x - style.CellPadding.x  - first_column_size - Utils::game_cover_size.x };
 
 		auto second_column_text = [&second_column_width]( const char* _text )
@@ -974,15 +1192,33 @@ namespace SplitsMgr
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Played:" );
-			second_column_text( Utils::time_to_str( m_played ).c_str() );
+			second_column_text( Utils::format_time( m_played ).c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Estimate:" );
-			second_column_text( Utils::time_to_str( m_estimation ).c_str() );
+			second_column_text( Utils::format_time( m_estimation ).c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Delta:" );
-			second_column_text( Utils::time_to_str( m_delta ).c_str() );
+			second_column_text( Utils::format_time( m_delta ).c_str() );
+
+			// The games of the list creator aren't in the loaded list, their slot is always 0 and would give the projection of its first game.
+			const Schedule::Entry* entry{ m_list_index != nullptr ? g_splits_app->get_splits_manager().get_stats().get_schedule().get_entry( m_list_slot ) : nullptr };
+
+			if( entry != nullptr )
+			{
+				if( entry->m_projected && Utils::is_day_valid( entry->m_end_day ) )
+				{
+					const Options::OptionsDatas& options{ g_splits_app->get_options().get_options_datas() };
+					ImGui::TableNextColumn();
+					ImGui::TextColored( ImGui_fzn::color::light_yellow, "Projected start:" );
+					second_column_text( Utils::format_date( entry->m_start_day, options.m_date_format ).c_str() );
+
+					ImGui::TableNextColumn();
+					ImGui::TextColored( ImGui_fzn::color::light_yellow, "Projected end:" );
+					second_column_text( Utils::format_date( entry->m_end_day, options.m_date_format ).c_str() );
+				}
+			}
 
 			if( has_sessions() == false )
 			{
@@ -992,19 +1228,50 @@ namespace SplitsMgr
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Number of sessions:" );
-			second_column_text( fzn::Tools::Sprintf( "%d", m_splits.size() ).c_str() );
+			Utils::ShortStr nb_sessions{};
+			snprintf( nb_sessions.m_buffer.data(), nb_sessions.m_buffer.size(), "%zu", m_splits.size() );
+			second_column_text( nb_sessions.c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Average session:" );
-			second_column_text( Utils::time_to_str( m_stats.m_average_session_time ).c_str() );
+			second_column_text( Utils::format_time( stats.m_average_session_time ).c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Shortest session:" );
-			second_column_text( Utils::time_to_str( m_stats.m_shortest_session ).c_str() );
+			second_column_text( Utils::format_time( stats.m_shortest_session ).c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Longest session:" );
-			second_column_text( Utils::time_to_str( m_stats.m_longest_sesion ).c_str() );
+			second_column_text( Utils::format_time( stats.m_longest_sesion ).c_str() );
+
+			ImGui::TableNextColumn();
+			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Median session:" );
+			second_column_text( Utils::format_time( stats.m_median_session ).c_str() );
+
+			ImGui::TableNextColumn();
+			ImGui::TextColored( ImGui_fzn::color::light_yellow, "90th percentile:" );
+			second_column_text( Utils::format_time( stats.m_p90_session ).c_str() );
+
+			ImGui::TableNextColumn();
+			ImGui::TextColored( ImGui_fzn::color::light_yellow, "99th percentile:" );
+			second_column_text( Utils::format_time( stats.m_p99_session ).c_str() );
+
+			Utils::ShortStr streak{};
+			snprintf( streak.m_buffer.data(), streak.m_buffer.size(), "%u day(s)", stats.m_longest_streak );
+
+			ImGui::TableNextColumn();
+			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Longest streak:" );
+			second_column_text( streak.c_str() );
+
+			// A game that is over won't be played anymore, it has no current streak.
+			if( are_sessions_over() == false )
+			{
+				snprintf( streak.m_buffer.data(), streak.m_buffer.size(), "%u day(s)", stats.m_current_streak );
+
+				ImGui::TableNextColumn();
+				ImGui::TextColored( ImGui_fzn::color::light_yellow, "Current streak:" );
+				second_column_text( streak.c_str() );
+			}
 
 			ImGui::EndTable();
 		}
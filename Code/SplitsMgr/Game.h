@@ -2,11 +2,17 @@
 
 #include <string>
 #include <vector>
+#include <cassert>
 #include <chrono>
 #include <filesystem>
+#include <limits>
+#include <memory_resource>
+#include <span>
 
 #include <Externals/json/json.h>
 
+#include "QuantileSketch.h"
+#include "StreakTracker.h"
 #include "Utils.h"
 
 
@@ -21,16 +27,36 @@ class sf::Texture;
 namespace SplitsMgr
 {
 	class ListCreator;
+	class ListIndex;
 
+	/**
+	* @brief Compact session record. Split and session indexes and run time aren't stored, they are deduced from the position of the split in its game.
+	**/
 	struct Split
 	{
-		uint32_t m_split_index{ 0 };
-		uint32_t m_session_index{ 0 };
-		SplitTime m_run_time;
-		SplitTime m_segment_time;
-		SplitDate m_date;
+		static constexpr Utils::DayNumber no_date{ Utils::no_day };
+
+		/**
+		* @brief Sessions are stored in whole seconds, a shorter one would be saved as a 0 s session and dropped when the list is read again.
+		**/
+		static bool is_time_valid( const SplitTime& _time )	{ return _time >= std::chrono::seconds{ 1 }; }
+
+		SplitTime get_segment_time() const				{ return std::chrono::seconds{ m_seconds }; }
+		SplitDate get_date() const						{ return Utils::to_date( m_day ); }
+		void set_segment_time( const SplitTime& _time )
+		{
+			const int64_t seconds{ std::chrono::floor< std::chrono::seconds >( _time ).count() };
+			assert( seconds >= 0 && seconds <= std::numeric_limits< uint32_t >::max() && "A session duration has to fit in 32 bits." );
+
+			m_seconds = static_cast< uint32_t >( seconds );
+		}
+		void set_date( const SplitDate& _date )			{ m_day = Utils::to_day_number( _date ); }
+
+		uint32_t			m_seconds{ 0 };			// Duration of the session, in seconds.
+		Utils::DayNumber	m_day{ no_date };		// Date of the session, in days since 1970-01-01.
 	};
-	using Splits = std::vector< Split >;
+	static_assert( sizeof( Split ) == 8, "Splits are meant to stay small, they are scanned by all the stats." );
+	using Splits = std::pmr::vector< Split >;
 
 	class Game
 	{
@@ -65,6 +91,10 @@ namespace SplitsMgr
 		};
 
 		Game() {}
+		/**
+		* @brief Create an empty game whose splits will be allocated from the given memory resource.
+		**/
+		explicit Game( std::pmr::memory_resource* _resource );
 		Game( const Desc& _desc, Utils::ParsingInfos& _parsing_infos );
 
 		void display();
@@ -82,35 +112,56 @@ namespace SplitsMgr
 		bool are_sessions_over() const							{ return m_state == State::finished || m_state == State::abandonned; }
 		bool has_sessions() const;
 		State get_state() const									{ return m_state; }
-		void set_state( State _state )							{ m_state = _state; }
+		void set_state( State _state )							{ m_state = _state; _refresh_delta(); }
 		const char* get_state_str() const;
 		static const char* get_str_from_state( State _state );
 		State get_state_from_str( std::string_view _state ) const;
 		const Splits& get_splits() const						{ return m_splits; }
+		const QuantileSketch& get_session_sketch() const		{ return m_session_sketch; }
+		const StreakTracker& get_streaks() const				{ return m_streaks; }
+		uint32_t get_first_split_index() const;
+		SplitTime get_run_time_start() const;
+		uint32_t get_list_slot() const							{ return m_list_slot; }
+		const Desc& get_inserted_game() const					{ return m_inserted_game; }
+		/**
+		* @brief Give the game its position in the list, its first split index and starting run time will be read from the list index from now on.
+		* @param _list_index The index of the list the game is in.
+		* @param _slot The position of the game in the list.
+		**/
+		void set_list_slot( const ListIndex* _list_index, uint32_t _slot );
 		SplitTime get_run_time() const;
 		SplitTime get_estimate() const							{ return m_estimation; }
 		SplitTime get_delta() const								{ return m_delta; }
 		SplitTime get_played() const;
 		SplitTime get_last_valid_segment_time() const;
-		SplitDate get_begin_date() const						{ return m_stats.m_begin_date; }
+		Utils::DayNumber get_begin_day() const					{ return has_sessions() ? m_splits.front().m_day : Utils::no_day; }
 		sf::Texture* get_cover() const							{ return m_cover; }
 
 		/**
 		* @brief Add a session to the game, from timer or manual add. Run time will be determined thanks to the game splits themselves.
 		* @param _time The time of the session we want to add.
-		* @param _date The date of the session.
+		* @param _day The day of the session.
 		* @param _state The new state of the game.
 		**/
-		void add_session( const SplitTime& _time, const SplitDate& _date, State _state );
+		void add_session( const SplitTime& _time, Utils::DayNumber _day, State _state );
 		/**
-		* @brief Update game datas by incrementing its splits indexes and adding a time to their run time.
-		* @param _delta_to_add The time delta that has been added on a game before this one that we need to add.
+		* @brief Add several sessions at once, the game time is only refreshed after the last one.
+		* @param _splits The sessions to add, in chronological order. The ones without a whole second are skipped, the out of range days are dropped.
+		* @param _state The new state of the game.
 		**/
-		void update_data( const SplitTime& _delta_to_add );
+		void add_sessions( std::span< const Split > _splits, State _state );
 		/**
-		* @brief Calculate at which date the game could be finished, either by using its stats if it has any sessions, or the global stats compiled from all the previous games.
+		* @brief Change the time and day of a session. The game time and delta are updated from the difference with the previous time.
+		* @param _index The index of the session in the game.
+		* @param _time The new time of the session.
+		* @param _day The new day of the session.
 		**/
-		void compute_end_date();
+		void edit_session( uint32_t _index, const SplitTime& _time, Utils::DayNumber _day );
+		/**
+		* @brief Remove a session from the game. The game time and delta are updated by taking its time out.
+		* @param _index The index of the session in the game.
+		**/
+		void delete_session( uint32_t _index );
 
 		/**
 		* @brief Read the Json value containing all the informations about the game.
@@ -128,21 +179,30 @@ namespace SplitsMgr
 	private:
 		/**
 		* @brief Stats displayed in the finished game popup.
+		* They're only computed when displayed, and kept as long as the game, the global stats and the current day don't change.
 		**/
 		struct Stats
 		{
-			SplitTime m_average_session_time;
-			SplitTime m_shortest_session;
-			SplitTime m_longest_sesion;
+			uint32_t	m_data_version{ UINT32_MAX };	// Version of the game data the stats have been computed from.
+			uint32_t	m_global_version{ 0 };			// Version of the global stats used for the games without sessions.
+			Utils::DayNumber	m_today{ Utils::no_day };
+
+			SplitTime m_average_session_time{};
+			SplitTime m_shortest_session{};
+			SplitTime m_longest_sesion{};
+			SplitTime m_median_session{};
+			SplitTime m_p90_session{};
+			SplitTime m_p99_session{};
+			uint32_t	m_longest_streak{ 0 };
+			uint32_t	m_current_streak{ 0 };
 
-			SplitDate	m_begin_date{};					// The earliest date available in the game list.
 			uint32_t	m_remaining_days{};
 			uint32_t	m_remaining_played_days{};
 			uint32_t	m_remaining_sessions{ 0 };
 			SplitTime	m_avg_session_day{};			// Average time on the period between current day and starting day. (taking non played days in account)
 			float		m_avg_sessions_days{ 0.f };
 			SplitTime	m_avg_session_played_day{};		// Average time by played day
-			SplitDate	m_end_date{};
+			Utils::DayNumber	m_end_day{ Utils::no_day };
 			uint32_t	m_played_days{ 0 };
 			uint32_t	m_days_since_start{ 0 };
 		};
@@ -151,7 +211,15 @@ namespace SplitsMgr
 		* @brief Add a new session to the game using m_new_session_time.
 		**/
 		void _add_new_session_time();
+		/**
+		* @brief Edit or delete the session selected with a right click on its row.
+		**/
+		void _session_popup();
 		void _refresh_game_time();
+		/**
+		* @brief Update the delta from the played time and the estimate.
+		**/
+		void _refresh_delta();
 		void _refresh_state();
 
 		void _push_state_colors( State _state );
@@ -162,15 +230,35 @@ namespace SplitsMgr
 		void _estimate_and_delta( State _state );
 
 		void _select_cover();
+		/**
+		* @brief Right click menu to insert a new game above or under this one.
+		**/
+		void _insert_game_menu();
 
 		/**
 		* @brief Compute all game stats from its estimate, time played and sessions.
 		**/
 		void _compute_game_stats();
 		/**
+		* @brief Calculate at which date the game could be finished, either by using its stats if it has any sessions, or the global stats compiled from all the previous games.
+		**/
+		void _compute_end_date();
+		/**
+		* @brief Get the game stats, computing them first if they're outdated.
+		**/
+		const Stats& _get_stats();
+		/**
+		* @brief To call on any change of the sessions, played time or estimate, so the stats are computed again next time they're displayed.
+		**/
+		void _on_data_changed()									{ ++m_data_version; }
+		/**
 		* @brief Displayed computed game stats, weither be in its tooltip or in the finished game popup.
 		**/
 		void _display_game_stats_table( float _window_width );
+		/**
+		* @brief Display the end dates of the current game given by the forecast of the global stats, if it's done.
+		**/
+		void _display_forecast( const Options::OptionsDatas& _options );
 
 		std::string m_name;
 		SplitTime m_estimation{};
@@ -179,6 +267,12 @@ namespace SplitsMgr
 		State m_state{ State::none };
 
 		Splits m_splits;
+		QuantileSketch m_session_sketch;	// Durations of the sessions, kept up to date with each change of the splits so their quantiles don't need sorting them.
+		StreakTracker m_streaks;			// Consecutive days the game has been played on, kept up to date like the session sketch.
+		uint32_t m_first_split_index{ 1 };	// Index of the first split of the game in the whole list, the next ones follow. Only used until the game is in a list index.
+		SplitTime m_run_time_start{};		// Run time of the list when the game begins, the run time of each split is this plus the previous sessions. Only used until the game is in a list index.
+		const ListIndex* m_list_index{ nullptr };
+		uint32_t m_list_slot{ 0 };
 
 		sf::Texture* m_cover{ nullptr };
 		std::string m_cover_data{};
@@ -187,7 +281,16 @@ namespace SplitsMgr
 		std::string m_new_session_date;
 		State m_new_session_state{ State::playing };
 
+		uint32_t m_edited_session{ 0 };
+		std::string m_edited_session_time;
+		std::string m_edited_session_date;
+
+		std::string m_inserted_game_name;
+		std::string m_inserted_game_estimate;
+		Desc m_inserted_game;				// Last game requested to be inserted next to this one, read by the splits manager when handling the event.
+
 		bool m_finished_game_popup{ false };
+		uint32_t m_data_version{ 0 };
 		Stats m_stats;
 	};
 	using Games = std::vector< Game >;
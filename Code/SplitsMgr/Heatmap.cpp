@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <FZN/UI/ImGui.h>
+
+#include "Heatmap.h"
+
+
+namespace SplitsMgr
+{
+	static constexpr uint32_t nb_week_columns{ 54 };		// A year starting on a saturday and ending on a sunday covers 54 weeks.
+	static constexpr float min_cell_size{ 6.f };
+	static constexpr float max_cell_size{ 16.f };
+
+	// Nothing played, then up to 1h, 2h, 4h and more.
+	static constexpr std::array< uint32_t, Heatmap::nb_buckets - 1 > bucket_limits{ 1, 3600, 7200, 14400 };
+	static constexpr std::array< ImU32, Heatmap::nb_buckets > bucket_colors{ IM_COL32( 45, 51, 59, 255 ), IM_COL32( 14, 68, 41, 255 ), IM_COL32( 0, 109, 50, 255 ), IM_COL32( 38, 166, 65, 255 ), IM_COL32( 57, 211, 83, 255 ) };
+
+	static int32_t get_year( Utils::DayNumber _day )
+	{
+		return static_cast< int32_t >( Utils::to_date( _day ).year() );
+	}
+
+	static Utils::DayNumber get_first_day_of_year( int32_t _year )
+	{
+		return Utils::to_day_number( SplitDate{ std::chrono::year{ _year }, std::chrono::January, std::chrono::day{ 1 } } );
+	}
+
+	static uint32_t get_weekday( Utils::DayNumber _day )
+	{
+		return std::chrono::weekday{ std::chrono::sys_days{ std::chrono::days{ _day } } }.c_encoding();
+	}
+
+	void Heatmap::clear()
+	{
+		*this = Heatmap{};
+	}
+
+	void Heatmap::update( const SessionTable& _sessions, Utils::DayNumber _today )
+	{
+		if( _sessions.has_dates() == false || Utils::is_day_valid( _today ) == false )
+		{
+			clear();
+			return;
+		}
+
+		const Utils::DayNumber last_day{ std::max( _today, _sessions.get_last_day() ) };
+		const Utils::DayNumber first_day{ std::max( _sessions.get_first_day(), get_first_day_of_year( get_year( last_day ) - max_years + 1 ) ) };
+		const std::span< const uint32_t > day_seconds{ _sessions.get_day_seconds() };
+
+		if( first_day != m_first_day || last_day != m_last_day )
+		{
+			m_first_day = first_day;
+			m_last_day = last_day;
+			m_first_year = get_year( first_day );
+			m_last_year = get_year( last_day );
+			m_day_seconds.assign( static_cast< size_t >( last_day - first_day ) + 1, 0 );
+			m_buckets.assign( m_day_seconds.size(), 0 );
+			m_layout_dirty = true;
+		}
+
+		const size_t table_offset{ static_cast< size_t >( first_day - _sessions.get_first_day() ) };
+		const size_t nb_table_days{ std::min( day_seconds.size() - std::min( table_offset, day_seconds.size() ), m_day_seconds.size() ) };
+
+		for( size_t day_index{ 0 }; day_index < m_day_seconds.size(); ++day_index )
+		{
+			const uint32_t seconds{ day_index < nb_table_days ? day_seconds[ table_offset + day_index ] : 0 };
+			m_day_seconds[ day_index ] = seconds;
+
+			const uint8_t bucket{ static_cast< uint8_t >( _get_bucket( seconds ) ) };
+
+			if( bucket == m_buckets[ day_index ] )
+				continue;
+
+			m_buckets[ day_index ] = bucket;
+
+			if( m_layout_dirty == false )
+				_set_cell_color( day_index );
+		}
+	}
+
+	void Heatmap::display( const Options::OptionsDatas& _options )
+	{
+		if( m_day_seconds.empty() )
+			return;
+
+		// A new day is added without waiting for the next refresh, it hasn't been played yet.
+		const Utils::DayNumber today{ Utils::today() };
+
+		if( today > m_last_day && get_year( today ) - m_first_year < max_years )
+		{
+			m_day_seconds.resize( static_cast< size_t >( today - m_first_day ) + 1, 0 );
+			m_buckets.resize( m_day_seconds.size(), 0 );
+			m_last_day = today;
+			m_last_year = get_year( today );
+			m_layout_dirty = true;
+		}
+
+		const float cell_size{ std::clamp( std::floor( ImGui::GetContentRegionAvail().x / nb_week_columns ), min_cell_size, max_cell_size ) };
+
+		if( m_layout_dirty || cell_size != m_cell_size )
+		{
+			m_cell_size = cell_size;
+			_build_vertices();
+		}
+
+		const ImVec2 origin{ ImGui::GetCursorScreenPos() };
+		const ImVec2 size{ nb_week_columns * m_cell_size, _get_year_height() * static_cast< float >( m_last_year - m_first_year + 1 ) };
+		ImGui::Dummy( size );
+
+		if( ImGui::IsItemVisible() == false )
+			return;
+
+		// All the cells are reserved at once, only their position is offset to the calendar before being written.
+		// Ten years are at most 3,660 cells, so 14,640 vertices: a single reservation stays under the 65,536 vertices 16-bit indices can address.
+		// If the vertices already in the draw list would make it go past that, PrimReserve starts the cells on a new vertex offset.
+		ImDrawList* draw_list{ ImGui::GetWindowDrawList() };
+		const size_t nb_cells{ m_vertices.size() / 4 };
+		const ImVec2 white_pixel{ ImGui::GetFontTexUvWhitePixel() };
+
+		draw_list->PrimReserve( static_cast< int >( nb_cells * 6 ), static_cast< int >( m_vertices.size() ) );
+
+		auto get_position = [ &origin ]( const ImDrawVert& _vertex ) { return ImVec2{ _vertex.pos.x + origin.x, _vertex.pos.y + origin.y }; };
+
+		for( size_t cell{ 0 }; cell < nb_cells; ++cell )
+		{
+			const ImDrawVert* vertices{ &m_vertices[ cell * 4 ] };
+			draw_list->PrimQuadUV( get_position( vertices[ 0 ] ), get_position( vertices[ 1 ] ), get_position( vertices[ 2 ] ), get_position( vertices[ 3 ] ), white_pixel, white_pixel, white_pixel, white_pixel, vertices[ 0 ].col );
+		}
+
+		for( int32_t year{ m_last_year }; year >= m_first_year; --year )
+		{
+			Utils::ShortStr year_str{};
+			snprintf( year_str.m_buffer.data(), year_str.m_buffer.size(), "%d", year );
+			draw_list->AddText( { origin.x, origin.y + _get_year_height() * static_cast< float >( m_last_year - year ) }, ImGui::GetColorU32( ImGui_fzn::color::light_yellow ), year_str.c_str() );
+		}
+
+		if( ImGui::IsItemHovered() )
+		{
+			const Utils::DayNumber hovered_day{ _get_day_at( { ImGui::GetMousePos().x - origin.x, ImGui::GetMousePos().y - origin.y } ) };
+
+			if( Utils::is_day_valid( hovered_day ) )
+				ImGui::SetTooltip( "%s: %s", Utils::format_date( hovered_day, _options.m_date_format ).c_str(), Utils::format_time( std::chrono::seconds{ m_day_seconds[ static_cast< size_t >( hovered_day - m_first_day ) ] } ).c_str() );
+		}
+	}
+
+	size_t Heatmap::_get_bucket( uint32_t _seconds )
+	{
+		return static_cast< size_t >( std::ranges::upper_bound( bucket_limits, _seconds ) - bucket_limits.begin() );
+	}
+
+	void Heatmap::_build_vertices()
+	{
+		// A small gap between the cells so the days can be told apart.
+		const float gap{ std::max( 1.f, std::floor( m_cell_size / 6.f ) ) };
+		const float side{ m_cell_size - gap };
+
+		m_vertices.resize( m_day_seconds.size() * 4 );
+
+		for( size_t day_index{ 0 }; day_index < m_day_seconds.size(); ++day_index )
+		{
+			const ImVec2 position{ _get_cell_position( m_first_day + static_cast< Utils::DayNumber >( day_index ) ) };
+			ImDrawVert* vertices{ &m_vertices[ day_index * 4 ] };
+
+			vertices[ 0 ].pos = position;
+			vertices[ 1 ].pos = { position.x + side, position.y };
+			vertices[ 2 ].pos = { position.x + side, position.y + side };
+			vertices[ 3 ].pos = { position.x, position.y + side };
+
+			_set_cell_color( day_index );
+		}
+
+		m_layout_dirty = false;
+	}
+
+	void Heatmap::_set_cell_color( size_t _day_index )
+	{
+		const ImU32 color{ bucket_colors[ m_buckets[ _day_index ] ] };
+
+		for( size_t corner{ 0 }; corner < 4; ++corner )
+			m_vertices[ _day_index * 4 + corner ].col = color;
+	}
+
+	ImVec2 Heatmap::_get_cell_position( Utils::DayNumber _day ) const
+	{
+		// The most recent year is on top, each year's first week starts on the weekday of its first day.
+		const int32_t year{ get_year( _day ) };
+		const Utils::DayNumber first_day_of_year{ get_first_day_of_year( year ) };
+		const uint32_t cell_index{ static_cast< uint32_t >( _day - first_day_of_year ) + get_weekday( first_day_of_year ) };
+
+		return { static_cast< float >( cell_index / 7 ) * m_cell_size, _get_year_height() * static_cast< float >( m_last_year - year ) + ImGui::GetTextLineHeightWithSpacing() + static_cast< float >( cell_index % 7 ) * m_cell_size };
+	}
+
+	Utils::DayNumber Heatmap::_get_day_at( ImVec2 _position ) const
+	{
+		if( _position.x < 0.f || _position.y < 0.f || m_cell_size <= 0.f )
+			return Utils::no_day;
+
+		const int32_t year{ m_last_year - static_cast< int32_t >( _position.y / _get_year_height() ) };
+		const float row_position{ std::fmod( _position.y, _get_year_height() ) - ImGui::GetTextLineHeightWithSpacing() };
+
+		if( year < m_first_year || row_position < 0.f )
+			return Utils::no_day;
+
+		const uint32_t row{ static_cast< uint32_t >( row_position / m_cell_size ) };
+		const uint32_t column{ static_cast< uint32_t >( _position.x / m_cell_size ) };
+		const Utils::DayNumber first_day_of_year{ get_first_day_of_year( year ) };
+		const int32_t day_of_year{ static_cast< int32_t >( column * 7 + row ) - static_cast< int32_t >( get_weekday( first_day_of_year ) ) };
+
+		if( row >= 7 || day_of_year < 0 )
+			return Utils::no_day;
+
+		const Utils::DayNumber day{ first_day_of_year + day_of_year };
+
+		if( day < m_first_day || day > m_last_day || get_year( day ) != year )
+			return Utils::no_day;
+
+		return day;
+	}
+
+	float Heatmap::_get_year_height() const
+	{
+		// The year is written above its weeks.
+		return ImGui::GetTextLineHeightWithSpacing() + 7.f * m_cell_size + ImGui::GetStyle().ItemSpacing.y;
+	}
+}
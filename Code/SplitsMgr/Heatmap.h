@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include <Externals/ImGui/imgui.h>
+
+#include "Options.h"
+#include "SessionTable.h"
+#include "Utils.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Calendar of the play time of each day, a row of weeks for each year like the contributions of a GitHub profile.
+	* The cells are kept as a vertex list drawn at once, a cell only gets its colour changed when its day goes to another bucket of play time.
+	************************************************************************/
+	class Heatmap
+	{
+	public:
+		static constexpr int32_t	max_years{ 10 };		// Older years aren't shown, the calendar would get too high and the vertices too many.
+		static constexpr size_t		nb_buckets{ 5 };
+
+		void clear();
+		/**
+		* @brief Read the daily totals of the table. The cells are placed again only if the days shown changed.
+		**/
+		void update( const SessionTable& _sessions, Utils::DayNumber _today );
+		void display( const Options::OptionsDatas& _options );
+
+	private:
+		static size_t _get_bucket( uint32_t _seconds );
+		/**
+		* @brief Place the cells of all the days shown for the current cell size.
+		**/
+		void _build_vertices();
+		void _set_cell_color( size_t _day_index );
+		/**
+		* @brief Position of the top left corner of a day's cell, relative to the top left corner of the calendar.
+		**/
+		ImVec2 _get_cell_position( Utils::DayNumber _day ) const;
+		/**
+		* @brief Day of the cell under the given position relative to the calendar, Utils::no_day if it isn't on a shown day.
+		**/
+		Utils::DayNumber _get_day_at( ImVec2 _position ) const;
+		float _get_year_height() const;
+
+		std::vector< uint32_t >		m_day_seconds;			// Played seconds of each day shown, indexed by day number minus the first day.
+		std::vector< uint8_t >		m_buckets;
+		std::vector< ImDrawVert >	m_vertices;				// 4 for each day shown, in the same order.
+
+		Utils::DayNumber			m_first_day{ Utils::no_day };
+		Utils::DayNumber			m_last_day{ Utils::no_day };
+		int32_t						m_first_year{ 0 };
+		int32_t						m_last_year{ 0 };
+
+		float						m_cell_size{ 0.f };		// Cell size the vertices have been placed with, they're placed again when it changes.
+		bool						m_layout_dirty{ true };
+	};
+}
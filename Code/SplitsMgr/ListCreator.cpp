@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cctype>
 #include <codecvt>
 
 #include <FZN/Managers/FazonCore.h>
@@ -5,9 +7,12 @@
 #include <FZN/UI/ImGui.h>
 #include <FZN/Tools/Logging.h>
 
+#include "CsvReader.h"
 #include "ListCreator.h"
 #include "Event.h"
 
+#include <ShlObj.h>
+
 
 namespace SplitsMgr
 {
@@ -55,10 +60,22 @@ namespace SplitsMgr
 				ImGui::Checkbox( "Merge year and game name", &m_merge_year_and_game );
 				ImGui::SameLine();
 				ImGui_fzn::helper_simple_tooltip( "Combine year and game name to create a new name using this format: '<year> - <game name>'." );
+				ImGui::SameLine();
+				ImGui::Checkbox( "Log parsing", &m_log_parsing );
+				ImGui::SameLine();
+				ImGui_fzn::helper_simple_tooltip( "Write every parsed line and created game in the logs. Slows down the generation of big lists." );
 
 				if( ImGui_fzn::deactivable_button( "Generate Game List", m_game_list_source.empty() ) )
 					generate_game_list_from_copy_paste();
 
+				ImGui::SameLine();
+
+				if( ImGui::Button( "Import CSV..." ) )
+					_select_csv_file();
+
+				ImGui::SameLine();
+				ImGui_fzn::helper_simple_tooltip( "Create the list from a CSV file exported from the sheet. Its columns are found from their header, the selected fields will be updated accordingly." );
+
 				ImGui::PushStyleColor( ImGuiCol_Separator, ImGui_fzn::color::white );
 
 				ImGui::BeginChild( "Games", ImVec2{ 0.f, ImGui::GetContentRegionAvail().y - ImGui::GetFrameHeightWithSpacing() } );
@@ -110,60 +127,44 @@ namespace SplitsMgr
 		};
 	}
 
-	ListCreator::GameInfosMap ListCreator::_get_elements( std::string_view _raw_game_infos )
+	ListCreator::GameFields ListCreator::_get_elements( std::string_view _raw_game_infos ) const
 	{
-		StringVector elements{ fzn::Tools::split( _raw_game_infos, '\t', false ) };
+		GameFields fields{};
+		uint32_t field_index{ 0 };
 
-		auto get_next_selected_field = [this]( uint32_t _current_index = UINT32_MAX )
+		// Skipping the fields that aren't in the pasted text.
+		auto next_selected_field = [ this ]( uint32_t _index )
 		{
-			if( _current_index == UINT32_MAX )
-			{
-				_current_index = 0;
-
-				if( m_copy_paste_options[ _current_index ] )
-					return _current_index;
-			}
-
-			++_current_index;
+			while( _index < CopyPasteField::COUNT && m_copy_paste_options[ _index ] == false )
+				++_index;
 
-			while( _current_index < static_cast< uint32_t >( CopyPasteField::COUNT ) )
-			{
-				if( m_copy_paste_options[ _current_index ] )
-					return _current_index;
-
-				++_current_index;
-			}
-
-			return _current_index;
+			return _index;
 		};
 
-		uint32_t field_index{ get_next_selected_field() };
-		GameInfosMap result_map{ {CopyPasteField::state, ""},{CopyPasteField::year, ""},{CopyPasteField::name, ""},{CopyPasteField::type, ""},{CopyPasteField::platform, ""},{CopyPasteField::version, ""},{CopyPasteField::estimate, ""},{CopyPasteField::played, ""}, };
+		field_index = next_selected_field( field_index );
 
-		for( const std::string& element: elements )
+		while( field_index < CopyPasteField::COUNT )
 		{
-			result_map[ static_cast< CopyPasteField >( field_index ) ] = element;
-			field_index = get_next_selected_field( field_index );
+			const size_t tab{ _raw_game_infos.find( '\t' ) };
+			fields[ field_index ] = _raw_game_infos.substr( 0, tab );
 
-			if( field_index >= static_cast<uint32_t>( CopyPasteField::COUNT ) )
+			if( tab == std::string_view::npos )
 				break;
+
+			_raw_game_infos.remove_prefix( tab + 1 );
+			field_index = next_selected_field( field_index + 1 );
 		}
 
-		return result_map;
+		return fields;
 	}
 
-	Game::Desc ListCreator::create_desc_from_elements( GameInfosMap& _elements )
+	Game::Desc ListCreator::create_desc_from_elements( const GameFields& _elements ) const
 	{
 		auto game_desc = Game::Desc{};
 
-		if( _elements.empty() )
-			return game_desc;
-
-		std::string game_year{};
-
 		if( m_copy_paste_options[ CopyPasteField::state ] )
 		{
-			const std::string& state{ _elements[ CopyPasteField::state ] };
+			const std::string_view state{ _elements[ CopyPasteField::state ] };
 			// We don't want to consider replaced games or ignored years.
 			if( state.contains( "Remplac" ) || state.contains( "Ignor" ) )
 			{
@@ -180,21 +181,24 @@ namespace SplitsMgr
 
 		if( m_copy_paste_options[ CopyPasteField::name ] )
 		{
+			const std::string_view name{ _elements[ CopyPasteField::name ] };
+
 			if( m_merge_year_and_game && m_copy_paste_options[ CopyPasteField::year ] )
-				game_desc.m_name = fzn::Tools::Sprintf( "%s - %s", _elements[ CopyPasteField::year ].c_str(), _elements[ CopyPasteField::name ].c_str() );
+			{
+				const std::string_view year{ _elements[ CopyPasteField::year ] };
+
+				game_desc.m_name.reserve( year.size() + name.size() + 3 );
+				game_desc.m_name.append( year ).append( " - " ).append( name );
+			}
 			else
-				game_desc.m_name = _elements[ CopyPasteField::name ];
+				game_desc.m_name = name;
 		}
 
 		if( m_copy_paste_options[ CopyPasteField::estimate ] )
-		{
-			game_desc.m_estimation = Utils::get_time_from_string( _elements[ CopyPasteField::estimate ], _elements[ CopyPasteField::estimate ].size() > 5 ? "%4H:%M:%S" : "%4H:%M" );
-		}
+			game_desc.m_estimation = Utils::parse_time( _elements[ CopyPasteField::estimate ] );
 
 		if( m_copy_paste_options[ CopyPasteField::played ] )
-		{
-			game_desc.m_played = Utils::get_time_from_string( _elements[ CopyPasteField::played ], _elements[ CopyPasteField::played ].size() > 5 ? "%4H:%M:%S" : "%4H:%M" );
-		}
+			game_desc.m_played = Utils::parse_time( _elements[ CopyPasteField::played ] );
 
 		return game_desc;
 	}
@@ -215,46 +219,194 @@ namespace SplitsMgr
 
 		FZN_LOG( "Selected options: %s", options.c_str() );
 
+		const std::string_view source{ m_game_list_source };
+
 		m_games.clear();
-		m_games.reserve( 100 );
+		m_games.reserve( std::ranges::count( source, '\n' ) + 1 );
 
 		size_t cursor{ 0 };
-		size_t end_of_line{ std::string::npos };
+		size_t end_of_line{ std::string_view::npos };
 		Utils::ParsingInfos parsing_infos{};
-		GameInfosMap elements;
+		size_t current_game_index{ SIZE_MAX };
 		m_current_game = nullptr;
 
-		while( cursor < m_game_list_source.size() )
+		while( cursor < source.size() )
 		{
-			end_of_line = m_game_list_source.find_first_of( '\n', cursor );
+			end_of_line = source.find( '\n', cursor );
 
-			if( end_of_line == std::string::npos )	
+			if( end_of_line == std::string_view::npos )
 			{
-				end_of_line = m_game_list_source.size();
+				end_of_line = source.size();
 			}
 
-			std::string line = m_game_list_source.substr( cursor, end_of_line - cursor );
+			std::string_view line{ source.substr( cursor, end_of_line - cursor ) };
+			cursor = end_of_line + 1;
 
-			FZN_LOG( "Current line: %s", line.c_str() );
+			if( line.empty() == false && line.back() == '\r' )
+				line.remove_suffix( 1 );
 
-			elements = _get_elements( line );
-			auto game_desc{ create_desc_from_elements( elements ) };
+			if( m_log_parsing )
+				FZN_LOG( "Current line: %.*s", static_cast< int >( line.size() ), line.data() );
 
-			if( game_desc.is_valid() )
-			{
-				m_games.push_back( Game( game_desc, parsing_infos ) );
+			_add_game( create_desc_from_elements( _get_elements( line ) ), parsing_infos, current_game_index );
+		}
+
+		_set_current_game( current_game_index );
+	}
+
+	void ListCreator::generate_game_list_from_csv( const std::filesystem::path& _path )
+	{
+		FZN_LOG( "Generating game list from csv file %s...", _path.string().c_str() );
+
+		CsvReader reader{};
 
-				Game& last_game{ m_games.back() };
-				FZN_LOG( "Game added: %s (%s) | %s / %s", last_game.get_name().c_str(), last_game.get_state_str(), Utils::time_to_str( last_game.get_played() ).c_str(), Utils::time_to_str( last_game.get_estimate() ).c_str() );
+		if( reader.open( _path ) == false )
+		{
+			FZN_LOG( "Couldn't open %s.", _path.string().c_str() );
+			return;
+		}
+
+		std::vector< std::string_view > record{};
+		std::vector< CopyPasteField > column_fields{};
+
+		if( reader.read_record( record ) == false )
+		{
+			FZN_LOG( "Empty csv file." );
+			return;
+		}
+
+		m_copy_paste_options.fill( false );
 
-				if( m_current_game == nullptr && last_game.get_state() == Game::State::playing )
-					m_current_game = &last_game;
+		for( const std::string_view header : record )
+		{
+			const CopyPasteField field{ _get_field_from_header( header ) };
+			column_fields.push_back( field );
+
+			if( field < CopyPasteField::COUNT )
+				m_copy_paste_options[ field ] = true;
+		}
+
+		if( m_copy_paste_options[ CopyPasteField::name ] == false || m_copy_paste_options[ CopyPasteField::estimate ] == false )
+		{
+			FZN_LOG( "The csv file needs at least a name and an estimate column." );
+			return;
+		}
+
+		m_games.clear();
+		m_game_list_source.clear();
+
+		Utils::ParsingInfos parsing_infos{};
+		size_t current_game_index{ SIZE_MAX };
+		m_current_game = nullptr;
+
+		while( reader.read_record( record ) )
+		{
+			GameFields fields{};
+
+			for( size_t column{ 0 }; column < record.size() && column < column_fields.size(); ++column )
+			{
+				if( column_fields[ column ] < CopyPasteField::COUNT )
+					fields[ column_fields[ column ] ] = record[ column ];
 			}
 
-			cursor = end_of_line + 1;
+			if( m_log_parsing )
+				FZN_LOG( "Line %u: %u field(s)", static_cast< uint32_t >( reader.get_line() ), static_cast< uint32_t >( record.size() ) );
+
+			_add_game( create_desc_from_elements( fields ), parsing_infos, current_game_index );
 		}
 
-		if( m_current_game == nullptr && m_games.empty() == false )
+		_set_current_game( current_game_index );
+	}
+
+	void ListCreator::_select_csv_file()
+	{
+		char file[ MAX_PATH ];
+		OPENFILENAME open_file_name;
+		ZeroMemory( &open_file_name, sizeof( open_file_name ) );
+
+		open_file_name.lStructSize = sizeof( open_file_name );
+		open_file_name.hwndOwner = NULL;
+		open_file_name.lpstrFile = file;
+		open_file_name.lpstrFile[ 0 ] = '\0';
+		open_file_name.nMaxFile = sizeof( file );
+		open_file_name.lpstrFileTitle = NULL;
+		open_file_name.nMaxFileTitle = 0;
+		open_file_name.lpstrFilter =	"(*.csv) Comma Separated Values\0*.csv\0"
+										"(*.*) All files \0*.*\0";
+		GetOpenFileName( &open_file_name );
+
+		if( open_file_name.lpstrFile[ 0 ] != '\0' )
+			generate_game_list_from_csv( open_file_name.lpstrFile );
+	}
+
+	ListCreator::CopyPasteField ListCreator::_get_field_from_header( std::string_view _header )
+	{
+		struct HeaderAlias
+		{
+			std::string_view	m_name;
+			CopyPasteField		m_field;
+		};
+
+		// Lower case names, accented letters are compared as they are written in UTF-8.
+		static constexpr HeaderAlias aliases[]{
+			{ "state", state },			{ "etat", state },			{ "\xC3\xA9tat", state },		{ "\xC3\x89tat", state },		{ "statut", state },
+			{ "year", year },			{ "annee", year },			{ "ann\xC3\xA9" "e", year },
+			{ "name", name },			{ "game", name },			{ "nom", name },				{ "jeu", name },
+			{ "type", type },			{ "genre", type },
+			{ "platform", platform },	{ "plateforme", platform },	{ "console", platform },		{ "support", platform },
+			{ "version", version },
+			{ "estimate", estimate },	{ "estimation", estimate },	{ "estim\xC3\xA9", estimate },
+			{ "played", played },		{ "time played", played },	{ "temps jou\xC3\xA9", played },	{ "jou\xC3\xA9", played },
+		};
+
+		while( _header.empty() == false && _header.front() == ' ' )
+			_header.remove_prefix( 1 );
+
+		while( _header.empty() == false && _header.back() == ' ' )
+			_header.remove_suffix( 1 );
+
+		// Headers are short, the ones that don't fit can't be one of the aliases anyway.
+		std::array< char, 32 > lower_header{};
+
+		if( _header.size() > lower_header.size() )
+			return CopyPasteField::COUNT;
+
+		for( size_t index{ 0 }; index < _header.size(); ++index )
+			lower_header[ index ] = static_cast< char >( std::tolower( static_cast< unsigned char >( _header[ index ] ) ) );
+
+		const std::string_view header{ lower_header.data(), _header.size() };
+
+		for( const HeaderAlias& alias : aliases )
+		{
+			if( alias.m_name == header )
+				return alias.m_field;
+		}
+
+		return CopyPasteField::COUNT;
+	}
+
+	void ListCreator::_add_game( const Game::Desc& _desc, Utils::ParsingInfos& _parsing_infos, size_t& _current_game_index )
+	{
+		if( _desc.is_valid() == false )
+			return;
+
+		Game& last_game{ m_games.emplace_back( _desc, _parsing_infos ) };
+
+		if( m_log_parsing )
+			FZN_LOG( "Game added: %s (%s) | %s / %s", last_game.get_name().c_str(), last_game.get_state_str(), Utils::format_time( last_game.get_played() ).c_str(), Utils::format_time( last_game.get_estimate() ).c_str() );
+
+		if( _current_game_index == SIZE_MAX && last_game.get_state() == Game::State::playing )
+			_current_game_index = m_games.size() - 1;
+	}
+
+	void ListCreator::_set_current_game( size_t _current_game_index )
+	{
+		FZN_LOG( "%u games generated.", static_cast< uint32_t >( m_games.size() ) );
+
+		// The pointer is only taken once all the games have been added, the vector may have moved them before.
+		if( _current_game_index != SIZE_MAX )
+			m_current_game = &m_games[ _current_game_index ];
+		else if( m_games.empty() == false )
 			m_current_game = &m_games.front();
 
 		if( m_current_game != nullptr )
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <filesystem>
+
 #include "Game.h"
 
 
@@ -29,7 +31,7 @@ namespace SplitsMgr
 			COUNT
 		};
 
-		using GameInfosMap = std::unordered_map< CopyPasteField, std::string >;
+		using GameFields = std::array< std::string_view, CopyPasteField::COUNT >;		// Views on the pasted text, only valid while it isn't modified.
 
 		void show_creation_popup();
 		void display_creation_popup();
@@ -37,12 +39,31 @@ namespace SplitsMgr
 	private:
 		std::string copy_paste_field_to_str( CopyPasteField _value ) const;
 
-		GameInfosMap _get_elements( std::string_view _raw_game_infos );
-		Game::Desc create_desc_from_elements( GameInfosMap& _elements );
+		/**
+		* @brief Split a pasted line on tabs, each element going to the next selected field. Nothing is copied, the fields point into the line.
+		**/
+		GameFields _get_elements( std::string_view _raw_game_infos ) const;
+		Game::Desc create_desc_from_elements( const GameFields& _elements ) const;
 		void generate_game_list_from_copy_paste();
+		/**
+		* @brief Create the games from a CSV file, read record by record. Its columns are found from their header, the fields options are set accordingly.
+		**/
+		void generate_game_list_from_csv( const std::filesystem::path& _path );
+		void _select_csv_file();
+		/**
+		* @brief Field corresponding to a CSV column header, english and french names are recognized. COUNT if the column isn't used.
+		**/
+		static CopyPasteField _get_field_from_header( std::string_view _header );
+
+		void _add_game( const Game::Desc& _desc, Utils::ParsingInfos& _parsing_infos, size_t& _current_game_index );
+		/**
+		* @brief Once all the games have been added, set the current one: the first game being played, or the first of the list.
+		**/
+		void _set_current_game( size_t _current_game_index );
 
 		bool m_show_creation_popup{ false };
 		bool m_merge_year_and_game{ true };
+		bool m_log_parsing{ false };		// Log every parsed line and created game, slow on big lists.
 
 		std::string m_game_list_source{};
 
@@ -0,0 +1,108 @@
+#include <algorithm>
+
+#include "ListIndex.h"
+
+
+namespace SplitsMgr
+{
+	void ListIndex::clear()
+	{
+		m_nb_splits.clear();
+		m_milliseconds.clear();
+		m_nb_splits_tree.clear();
+		m_milliseconds_tree.clear();
+	}
+
+	/**
+	* @brief Fill the trees with the splits and played time of the given games, in list order.
+	**/
+	void ListIndex::rebuild( const Games& _games )
+	{
+		const size_t nb_games{ _games.size() };
+
+		m_nb_splits.resize( nb_games );
+		m_milliseconds.resize( nb_games );
+		m_nb_splits_tree.assign( nb_games + 1, 0 );
+		m_milliseconds_tree.assign( nb_games + 1, 0 );
+
+		for( size_t slot{ 0 }; slot < nb_games; ++slot )
+		{
+			m_nb_splits[ slot ] = static_cast< int32_t >( _games[ slot ].get_splits().size() );
+			m_milliseconds[ slot ] = _games[ slot ].get_played().count();
+		}
+
+		// Linear construction, each node gives its sum to its parent once it's complete.
+		for( size_t node{ 1 }; node <= nb_games; ++node )
+		{
+			m_nb_splits_tree[ node ] += m_nb_splits[ node - 1 ];
+			m_milliseconds_tree[ node ] += m_milliseconds[ node - 1 ];
+
+			const size_t parent{ node + ( node & ( ~node + 1 ) ) };
+
+			if( parent <= nb_games )
+			{
+				m_nb_splits_tree[ parent ] += m_nb_splits_tree[ node ];
+				m_milliseconds_tree[ parent ] += m_milliseconds_tree[ node ];
+			}
+		}
+	}
+
+	void ListIndex::refresh( uint32_t _slot, const Game& _game )
+	{
+		if( _slot >= m_nb_splits.size() )
+			return;
+
+		_set( _slot, static_cast< int32_t >( _game.get_splits().size() ), _game.get_played().count() );
+	}
+
+	void ListIndex::move( uint32_t _from, uint32_t _to, const Games& _games )
+	{
+		if( _from == _to || _from >= m_nb_splits.size() || _to >= m_nb_splits.size() || _games.size() != m_nb_splits.size() )
+			return;
+
+		// Only the positions between the two ones changed game, the sums before and after them stay the same.
+		const uint32_t first{ std::min( _from, _to ) };
+		const uint32_t last{ std::max( _from, _to ) };
+
+		for( uint32_t slot{ first }; slot <= last; ++slot )
+			refresh( slot, _games[ slot ] );
+	}
+
+	uint32_t ListIndex::get_first_split_index( uint32_t _slot ) const
+	{
+		int32_t nb_splits{ 0 };
+
+		for( size_t node{ std::min< size_t >( _slot, m_nb_splits.size() ) }; node > 0; node &= node - 1 )
+			nb_splits += m_nb_splits_tree[ node ];
+
+		return static_cast< uint32_t >( nb_splits ) + 1;
+	}
+
+	SplitTime ListIndex::get_run_time_start( uint32_t _slot ) const
+	{
+		int64_t milliseconds{ 0 };
+
+		for( size_t node{ std::min< size_t >( _slot, m_nb_splits.size() ) }; node > 0; node &= node - 1 )
+			milliseconds += m_milliseconds_tree[ node ];
+
+		return SplitTime{ milliseconds };
+	}
+
+	void ListIndex::_set( uint32_t _slot, int32_t _nb_splits, int64_t _milliseconds )
+	{
+		const int32_t nb_splits_delta{ _nb_splits - m_nb_splits[ _slot ] };
+		const int64_t milliseconds_delta{ _milliseconds - m_milliseconds[ _slot ] };
+
+		if( nb_splits_delta == 0 && milliseconds_delta == 0 )
+			return;
+
+		m_nb_splits[ _slot ] = _nb_splits;
+		m_milliseconds[ _slot ] = _milliseconds;
+
+		for( size_t node{ _slot + 1u }; node < m_nb_splits_tree.size(); node += node & ( ~node + 1 ) )
+		{
+			m_nb_splits_tree[ node ] += nb_splits_delta;
+			m_milliseconds_tree[ node ] += milliseconds_delta;
+		}
+	}
+}
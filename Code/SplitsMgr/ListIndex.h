@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Number of splits and played time of each game, by position in the list, stored in Fenwick trees.
+	* The first split index and starting run time of a game are prefix sums over the games before it, they're read and updated in O(log n)
+	* so adding a session or moving a game doesn't have to go through all the games after it.
+	************************************************************************/
+	class ListIndex
+	{
+	public:
+		void clear();
+		/**
+		* @brief Fill the trees with the splits and played time of the given games, in list order.
+		**/
+		void rebuild( const Games& _games );
+		/**
+		* @brief Update the position of a game after its sessions changed.
+		* @param _slot The position of the game in the list.
+		* @param _game The game, with its new sessions.
+		**/
+		void refresh( uint32_t _slot, const Game& _game );
+		/**
+		* @brief Update the positions between _from and _to after a game has been moved from one to the other, the games in between being shifted by one.
+		* @param _games The games, already in their new order.
+		**/
+		void move( uint32_t _from, uint32_t _to, const Games& _games );
+
+		size_t		get_nb_games() const		{ return m_nb_splits.size(); }
+		/**
+		* @brief Index of the first split of the game at the given position in the whole list, starting at 1.
+		**/
+		uint32_t	get_first_split_index( uint32_t _slot ) const;
+		/**
+		* @brief Played time of all the games before the given position.
+		**/
+		SplitTime	get_run_time_start( uint32_t _slot ) const;
+
+	private:
+		/**
+		* @brief Set the values of a position, updating the trees with the difference from the previous ones.
+		**/
+		void _set( uint32_t _slot, int32_t _nb_splits, int64_t _milliseconds );
+
+		std::vector< int32_t >	m_nb_splits;			// Number of splits of each game.
+		std::vector< int64_t >	m_milliseconds;			// Played time of each game.
+
+		std::vector< int32_t >	m_nb_splits_tree;		// Fenwick tree of m_nb_splits, node i holds the sum of the 'i & -i' values ending at i (starting at 1).
+		std::vector< int64_t >	m_milliseconds_tree;	// Fenwick tree of m_milliseconds.
+	};
+}
@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <charconv>
+
+#include <tinyXML2/tinyxml2.h>
+
+#include <FZN/Tools/Logging.h>
+
+#include "LssReader.h"
+
+
+namespace SplitsMgr
+{
+	/**
+	* @brief Attempts are started on "month/day/year hours:minutes:seconds", in UTC.
+	**/
+	static Utils::DayNumber get_day_from_attempt_date( std::string_view _date )
+	{
+		int values[ 3 ]{};
+		const char* current{ _date.data() };
+		const char* const end{ _date.data() + _date.size() };
+
+		for( int value_index{ 0 }; value_index < 3; ++value_index )
+		{
+			if( value_index > 0 )
+			{
+				if( current == end || *current != '/' )
+					return Utils::no_day;
+
+				++current;
+			}
+
+			const auto [ number_end, error ] = std::from_chars( current, end, values[ value_index ] );
+
+			if( error != std::errc{} )
+				return Utils::no_day;
+
+			current = number_end;
+		}
+
+		if( values[ 0 ] < 1 || values[ 0 ] > 12 || values[ 1 ] < 1 || values[ 1 ] > 31 )
+			return Utils::no_day;
+
+		const SplitDate date{ std::chrono::year{ values[ 2 ] }, std::chrono::month{ static_cast< unsigned >( values[ 0 ] ) }, std::chrono::day{ static_cast< unsigned >( values[ 1 ] ) } };
+
+		return date.ok() ? Utils::to_day_number( date ) : Utils::no_day;
+	}
+
+	SplitTime LssReader::Segment::get_estimate( SplitTime& _previous_personal_best ) const
+	{
+		// The personal best is the run time at the end of each segment, the estimate of a game is its part of it.
+		if( Utils::is_time_valid( m_personal_best ) && m_personal_best > _previous_personal_best )
+		{
+			const SplitTime estimate{ m_personal_best - _previous_personal_best };
+			_previous_personal_best = m_personal_best;
+
+			return estimate;
+		}
+
+		SplitTime estimate{};
+
+		for( const Split& session : m_sessions )
+			estimate += session.get_segment_time();
+
+		return estimate;
+	}
+
+	LssReader::LssReader()
+		: m_document( std::make_unique< tinyxml2::XMLDocument >() )
+	{
+	}
+
+	LssReader::~LssReader()
+	{
+	}
+
+	bool LssReader::open( const std::filesystem::path& _path )
+	{
+		close();
+
+		m_file.open( _path, std::ios::binary );
+
+		return m_file.is_open();
+	}
+
+	void LssReader::close()
+	{
+		if( m_file.is_open() )
+			m_file.close();
+
+		m_buffer.clear();
+		m_position = 0;
+		m_scan_offset = 0;
+		m_game_name.clear();
+		m_category_name.clear();
+		m_attempt_days.clear();
+		m_nb_attempts = 0;
+		m_last_attempt_id = 0;
+	}
+
+	bool LssReader::read_segment( Segment& _segment )
+	{
+		Element element{ Element::COUNT };
+		std::string_view fragment{};
+
+		while( _next_element( element, fragment ) )
+		{
+			if( _parse_fragment( fragment ) == false )
+				continue;
+
+			switch( element )
+			{
+				case Element::game_name:
+				{
+					const char* text{ m_document->RootElement()->GetText() };
+					m_game_name = text != nullptr ? text : "";
+					break;
+				}
+				case Element::category_name:
+				{
+					const char* text{ m_document->RootElement()->GetText() };
+					m_category_name = text != nullptr ? text : "";
+					break;
+				}
+				case Element::attempt:
+				{
+					_read_attempt();
+					break;
+				}
+				case Element::segment:
+				{
+					_read_segment( _segment );
+					return true;
+				}
+				default:
+					break;
+			}
+		}
+
+		return false;
+	}
+
+	bool LssReader::_next_element( Element& _element, std::string_view& _fragment )
+	{
+		static constexpr std::array< std::string_view, Element::COUNT > tags{ "GameName", "CategoryName", "Attempt", "Segment" };
+		static constexpr size_t longest_tag{ 12 };
+
+		while( true )
+		{
+			const size_t tag_begin{ m_buffer.find( '<', m_position ) };
+
+			if( tag_begin == std::string::npos )
+			{
+				m_position = m_buffer.size();
+
+				if( _fill_buffer() == false )
+					return false;
+
+				continue;
+			}
+
+			// The whole name and the character after it are needed to tell "Segment" from "Segments" or "SegmentHistory".
+			if( m_buffer.size() - tag_begin < longest_tag + 2 )
+			{
+				m_position = tag_begin;
+
+				if( _fill_buffer() )
+					continue;
+			}
+
+			const std::string_view tag_start{ std::string_view{ m_buffer }.substr( tag_begin + 1 ) };
+			size_t found_element{ Element::COUNT };
+
+			for( size_t element{ 0 }; element < tags.size(); ++element )
+			{
+				if( tag_start.starts_with( tags[ element ] ) == false || tag_start.size() <= tags[ element ].size() )
+					continue;
+
+				const char next_char{ tag_start[ tags[ element ].size() ] };
+
+				if( next_char == '>' || next_char == '/' || next_char == ' ' || next_char == '\t' || next_char == '\r' || next_char == '\n' )
+				{
+					found_element = element;
+					break;
+				}
+			}
+
+			if( found_element == Element::COUNT )
+			{
+				m_position = tag_begin + 1;
+				continue;
+			}
+
+			const size_t opening_end{ m_buffer.find( '>', tag_begin ) };
+			size_t fragment_end{ std::string::npos };
+
+			if( opening_end != std::string::npos && m_buffer[ opening_end - 1 ] == '/' )
+				fragment_end = opening_end + 1;
+			else if( opening_end != std::string::npos )
+			{
+				// Closing tags of the children starting with the same name, like "</SegmentHistory>", are skipped.
+				// The part of an unfinished element already searched isn't searched again after each chunk.
+				const std::string_view tag{ tags[ found_element ] };
+				const size_t search_begin{ std::max( opening_end, tag_begin + m_scan_offset ) };
+
+				for( size_t closing_tag{ m_buffer.find( "</", search_begin ) }; closing_tag != std::string::npos; closing_tag = m_buffer.find( "</", closing_tag + 2 ) )
+				{
+					const std::string_view closing_name{ std::string_view{ m_buffer }.substr( closing_tag + 2 ) };
+
+					if( closing_name.size() > tag.size() && closing_name.starts_with( tag ) && closing_name[ tag.size() ] == '>' )
+					{
+						fragment_end = closing_tag + 3 + tag.size();
+						break;
+					}
+				}
+			}
+
+			// The element isn't complete in the buffer, it's read again from its beginning once more of the file has been added.
+			// Its closing tag is then searched from the last one that was cut by the end of the buffer.
+			if( fragment_end == std::string::npos )
+			{
+				if( opening_end != std::string::npos )
+				{
+					const size_t undecided_begin{ m_buffer.size() - std::min( m_buffer.size(), tags[ found_element ].size() + 3 ) };
+					m_scan_offset = std::max( opening_end, undecided_begin ) - tag_begin;
+				}
+
+				m_position = tag_begin;
+
+				if( _fill_buffer() == false )
+				{
+					FZN_LOG( "Unfinished %s element at the end of the file.", tags[ found_element ].data() );
+					return false;
+				}
+
+				continue;
+			}
+
+			_element = static_cast< Element >( found_element );
+			_fragment = std::string_view{ m_buffer }.substr( tag_begin, fragment_end - tag_begin );
+			m_position = fragment_end;
+			m_scan_offset = 0;
+
+			return true;
+		}
+	}
+
+	bool LssReader::_fill_buffer()
+	{
+		if( m_file.is_open() == false || m_file.eof() )
+			return false;
+
+		m_buffer.erase( 0, m_position );
+		m_position = 0;
+
+		const size_t previous_size{ m_buffer.size() };
+		m_buffer.resize( previous_size + chunk_size );
+
+		m_file.read( m_buffer.data() + previous_size, chunk_size );
+		const size_t read_size{ static_cast< size_t >( m_file.gcount() ) };
+
+		m_buffer.resize( previous_size + read_size );
+
+		return read_size > 0;
+	}
+
+	bool LssReader::_parse_fragment( std::string_view _fragment )
+	{
+		if( m_document->Parse( _fragment.data(), _fragment.size() ) != tinyxml2::XML_SUCCESS || m_document->RootElement() == nullptr )
+		{
+			FZN_LOG( "Couldn't parse element: %s", m_document->ErrorStr() );
+			return false;
+		}
+
+		return true;
+	}
+
+	void LssReader::_read_attempt()
+	{
+		const tinyxml2::XMLElement* attempt_element{ m_document->RootElement() };
+		const int id{ attempt_element->IntAttribute( "id", 0 ) };
+		const char* started{ attempt_element->Attribute( "started" ) };
+
+		++m_nb_attempts;
+
+		if( id > m_last_attempt_id )
+			m_last_attempt_id = id;
+
+		if( id <= 0 || started == nullptr )
+			return;
+
+		if( static_cast< size_t >( id ) >= m_attempt_days.size() )
+			m_attempt_days.resize( static_cast< size_t >( id ) + 1, Utils::no_day );
+
+		m_attempt_days[ id ] = Utils::check_session_day( get_day_from_attempt_date( started ) );
+	}
+
+	void LssReader::_read_segment( Segment& _segment )
+	{
+		tinyxml2::XMLElement* segment_element{ m_document->RootElement() };
+
+		_segment.m_name = Utils::get_xml_child_element_text( segment_element, "Name" );
+		_segment.m_personal_best = SplitTime{};
+		_segment.m_sessions.clear();
+		_segment.m_split_in_last_attempt = false;
+
+		if( tinyxml2::XMLElement* split_times{ segment_element->FirstChildElement( "SplitTimes" ) } )
+		{
+			for( tinyxml2::XMLElement* split_time{ split_times->FirstChildElement( "SplitTime" ) }; split_time != nullptr; split_time = split_time->NextSiblingElement( "SplitTime" ) )
+			{
+				if( split_time->Attribute( "name", "Personal Best" ) )
+				{
+					_segment.m_personal_best = Utils::parse_time( Utils::get_xml_child_element_text( split_time, "RealTime" ) );
+					break;
+				}
+			}
+		}
+
+		tinyxml2::XMLElement* history{ segment_element->FirstChildElement( "SegmentHistory" ) };
+
+		if( history == nullptr )
+			return;
+
+		for( tinyxml2::XMLElement* time{ history->FirstChildElement( "Time" ) }; time != nullptr; time = time->NextSiblingElement( "Time" ) )
+		{
+			// Sessions timed in game time only don't have a real time, they can't be added to the list.
+			const tinyxml2::XMLElement* real_time{ time->FirstChildElement( "RealTime" ) };
+
+			if( real_time == nullptr || real_time->GetText() == nullptr )
+				continue;
+
+			const SplitTime session_time{ Utils::parse_time( real_time->GetText() ) };
+
+			if( Utils::is_time_valid( session_time ) == false )
+				continue;
+
+			// Negative ids are kept from cleaned histories and don't have an attempt anymore.
+			const int id{ time->IntAttribute( "id", 0 ) };
+
+			if( id > 0 && id == m_last_attempt_id )
+				_segment.m_split_in_last_attempt = true;
+
+			Split session{};
+			session.set_segment_time( session_time );
+			session.m_day = id > 0 && static_cast< size_t >( id ) < m_attempt_days.size() ? m_attempt_days[ id ] : Split::no_date;
+
+			_segment.m_sessions.push_back( session );
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Read a LiveSplit splits file (.lss) segment by segment.
+	* The file is read in fixed size chunks and only the elements the list needs are cut out of it: the run names, the attempts and the segments.
+	* Each of them is parsed on its own in a reused document, so a long history never has to be held as a whole tree.
+	************************************************************************/
+	class LssReader
+	{
+	public:
+		static constexpr size_t chunk_size{ 64 * 1024 };
+
+		/**
+		* @brief A segment of the run, which is a game of the list. Its sessions are the segment history, dated by the attempt they were played in.
+		**/
+		struct Segment
+		{
+			/**
+			* @brief Part of the personal best played on the segment, or the time of its whole history if it isn't part of it.
+			* @param [in out] _previous_personal_best Personal best at the end of the segments before, moved to the end of this one.
+			**/
+			SplitTime get_estimate( SplitTime& _previous_personal_best ) const;
+
+			std::string				m_name;
+			SplitTime				m_personal_best{};		// Run time at the end of the segment in the personal best, empty if there isn't any.
+			std::vector< Split >	m_sessions;
+			bool					m_split_in_last_attempt{ false };		// The last attempt of the file has a time for the segment, it went past it.
+		};
+
+		LssReader();
+		~LssReader();
+
+		bool open( const std::filesystem::path& _path );
+		void close();
+
+		/**
+		* @brief Read the next segment of the file. The attempts met before it are kept to date the sessions of all the segments.
+		* @param [out] _segment The segment, reused between calls so its history doesn't allocate again.
+		* @return False once there are no more segments in the file.
+		**/
+		bool read_segment( Segment& _segment );
+
+		const std::string&	get_game_name() const		{ return m_game_name; }
+		const std::string&	get_category_name() const	{ return m_category_name; }
+		size_t				get_nb_attempts() const		{ return m_nb_attempts; }
+
+	private:
+		enum Element
+		{
+			game_name,
+			category_name,
+			attempt,
+			segment,
+			COUNT
+		};
+
+		/**
+		* @brief Cut the next element among the read ones out of the file.
+		* @param [out] _element Which element has been found.
+		* @param [out] _fragment The whole element, from its opening tag to its closing one. Only valid until the next call.
+		* @return False at the end of the file.
+		**/
+		bool _next_element( Element& _element, std::string_view& _fragment );
+		/**
+		* @brief Drop what has been read from the buffer and append the next chunk of the file.
+		* @return False if there was nothing left to read.
+		**/
+		bool _fill_buffer();
+		bool _parse_fragment( std::string_view _fragment );
+		void _read_attempt();
+		void _read_segment( Segment& _segment );
+
+		std::ifstream							m_file;
+		std::string								m_buffer;
+		size_t									m_position{ 0 };
+		size_t									m_scan_offset{ 0 };		// Where the search for the closing tag of an unfinished element resumes, from its opening tag.
+
+		std::unique_ptr< tinyxml2::XMLDocument >	m_document;		// Reused for every element, tinyxml2 keeps its memory pools between parses.
+
+		std::string								m_game_name;
+		std::string								m_category_name;
+		std::vector< Utils::DayNumber >			m_attempt_days;		// Day each attempt started on, indexed by attempt id.
+		size_t									m_nb_attempts{ 0 };
+		int										m_last_attempt_id{ 0 };
+	};
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+
+#include "QuantileSketch.h"
+
+
+namespace SplitsMgr
+{
+	// Ratio between the bounds of a bucket, the middle of a bucket is within relative_accuracy of all its values.
+	static const double bucket_ratio{ ( 1.0 + QuantileSketch::relative_accuracy ) / ( 1.0 - QuantileSketch::relative_accuracy ) };
+	static const double log_bucket_ratio{ std::log( bucket_ratio ) };
+
+	QuantileSketch::QuantileSketch( std::pmr::memory_resource* _resource )
+		: m_counts( _resource )
+	{
+	}
+
+	void QuantileSketch::clear()
+	{
+		m_counts.clear();
+		m_first_bucket = 0;
+		m_zero_count = 0;
+		m_count = 0;
+	}
+
+	void QuantileSketch::add( uint32_t _seconds )
+	{
+		++m_count;
+
+		if( _seconds == 0 )
+		{
+			++m_zero_count;
+			return;
+		}
+
+		const int32_t bucket{ _get_bucket( _seconds ) };
+
+		if( m_counts.empty() )
+		{
+			m_first_bucket = bucket;
+			m_counts.push_back( 0 );
+		}
+		else if( bucket < m_first_bucket )
+		{
+			m_counts.insert( m_counts.begin(), static_cast< size_t >( m_first_bucket - bucket ), 0 );
+			m_first_bucket = bucket;
+		}
+		else if( bucket >= m_first_bucket + static_cast< int32_t >( m_counts.size() ) )
+			m_counts.resize( static_cast< size_t >( bucket - m_first_bucket ) + 1, 0 );
+
+		++m_counts[ static_cast< size_t >( bucket - m_first_bucket ) ];
+	}
+
+	bool QuantileSketch::remove( uint32_t _seconds )
+	{
+		if( _seconds == 0 )
+		{
+			if( m_zero_count == 0 )
+				return false;
+
+			--m_zero_count;
+			--m_count;
+			return true;
+		}
+
+		const int32_t bucket{ _get_bucket( _seconds ) };
+
+		if( bucket < m_first_bucket || bucket >= m_first_bucket + static_cast< int32_t >( m_counts.size() ) || m_counts[ static_cast< size_t >( bucket - m_first_bucket ) ] == 0 )
+			return false;
+
+		--m_counts[ static_cast< size_t >( bucket - m_first_bucket ) ];
+		--m_count;
+
+		// Empty buckets are trimmed from the ends, so a sketch is the same whatever the order its durations have been added and removed in.
+		const auto first_used{ std::ranges::find_if( m_counts, []( uint32_t _count ) { return _count > 0; } ) };
+
+		if( first_used == m_counts.end() )
+		{
+			m_counts.clear();
+			m_first_bucket = 0;
+			return true;
+		}
+
+		m_first_bucket += static_cast< int32_t >( first_used - m_counts.begin() );
+		m_counts.erase( m_counts.begin(), first_used );
+
+		while( m_counts.back() == 0 )
+			m_counts.pop_back();
+
+		return true;
+	}
+
+	void QuantileSketch::merge( const QuantileSketch& _other )
+	{
+		m_count += _other.m_count;
+		m_zero_count += _other.m_zero_count;
+
+		if( _other.m_counts.empty() )
+			return;
+
+		if( m_counts.empty() )
+		{
+			m_counts.assign( _other.m_counts.begin(), _other.m_counts.end() );
+			m_first_bucket = _other.m_first_bucket;
+			return;
+		}
+
+		const int32_t first_bucket{ std::min( m_first_bucket, _other.m_first_bucket ) };
+		const int32_t end_bucket{ std::max( m_first_bucket + static_cast< int32_t >( m_counts.size() ), _other.m_first_bucket + static_cast< int32_t >( _other.m_counts.size() ) ) };
+
+		m_counts.insert( m_counts.begin(), static_cast< size_t >( m_first_bucket - first_bucket ), 0 );
+		m_counts.resize( static_cast< size_t >( end_bucket - first_bucket ), 0 );
+		m_first_bucket = first_bucket;
+
+		const size_t offset{ static_cast< size_t >( _other.m_first_bucket - m_first_bucket ) };
+
+		for( size_t bucket{ 0 }; bucket < _other.m_counts.size(); ++bucket )
+			m_counts[ offset + bucket ] += _other.m_counts[ bucket ];
+	}
+
+	SplitTime QuantileSketch::get_quantile( double _quantile ) const
+	{
+		if( m_count == 0 )
+			return SplitTime{};
+
+		const uint32_t rank{ static_cast< uint32_t >( std::clamp( _quantile, 0.0, 1.0 ) * ( m_count - 1 ) ) };
+
+		if( rank < m_zero_count )
+			return SplitTime{};
+
+		uint32_t nb_durations{ m_zero_count };
+
+		for( size_t bucket{ 0 }; bucket < m_counts.size(); ++bucket )
+		{
+			nb_durations += m_counts[ bucket ];
+
+			if( rank < nb_durations )
+				return std::chrono::seconds{ std::llround( _get_bucket_value( m_first_bucket + static_cast< int32_t >( bucket ) ) ) };
+		}
+
+		return std::chrono::seconds{ std::llround( _get_bucket_value( m_first_bucket + static_cast< int32_t >( m_counts.size() ) - 1 ) ) };
+	}
+
+	int32_t QuantileSketch::_get_bucket( uint32_t _seconds )
+	{
+		return static_cast< int32_t >( std::ceil( std::log( static_cast< double >( _seconds ) ) / log_bucket_ratio ) );
+	}
+
+	double QuantileSketch::_get_bucket_value( int32_t _bucket )
+	{
+		// A bucket holds the durations between bucket_ratio^( bucket - 1 ) and bucket_ratio^bucket.
+		return 2.0 * std::pow( bucket_ratio, _bucket ) / ( bucket_ratio + 1.0 );
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+
+#include "Utils.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Approximate quantiles of session durations, kept in buckets growing by a constant ratio so each quantile is within relative_accuracy of the real one.
+	* Durations can be added and removed in any order, and two sketches are merged by adding their buckets, which gives the sketch of all their sessions.
+	************************************************************************/
+	class QuantileSketch
+	{
+	public:
+		static constexpr double relative_accuracy{ 0.01 };
+
+		explicit QuantileSketch( std::pmr::memory_resource* _resource = std::pmr::get_default_resource() );
+
+		void clear();
+		void add( uint32_t _seconds );
+		/**
+		* @return False if the sketch has no duration in the bucket of the given one.
+		**/
+		bool remove( uint32_t _seconds );
+		void merge( const QuantileSketch& _other );
+
+		uint32_t get_count() const		{ return m_count; }
+		/**
+		* @brief Duration below which the given part of the durations are, 0.5 being the median.
+		**/
+		SplitTime get_quantile( double _quantile ) const;
+
+		bool operator==( const QuantileSketch& _other ) const = default;
+
+	private:
+		static int32_t _get_bucket( uint32_t _seconds );
+		static double _get_bucket_value( int32_t _bucket );
+
+		std::pmr::vector< uint32_t >	m_counts;				// Number of durations in each bucket from the first one, without empty buckets at the ends.
+		int32_t							m_first_bucket{ 0 };
+		uint32_t						m_zero_count{ 0 };		// Durations under a second, they can't be put in a bucket.
+		uint32_t						m_count{ 0 };
+	};
+}
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cmath>
+
+#include "RateModel.h"
+
+
+namespace SplitsMgr
+{
+	// Weight a day loses each day, so it's halved after half_life days.
+	static const double decay{ std::pow( 0.5, 1.0 / RateModel::half_life ) };
+
+	void RateModel::clear()
+	{
+		*this = RateModel{};
+	}
+
+	void RateModel::rebuild( const SessionTable& _sessions, Utils::DayNumber _today )
+	{
+		clear();
+
+		if( _sessions.has_dates() == false )
+			return;
+
+		const std::span< const uint32_t > day_seconds{ _sessions.get_day_seconds() };
+		m_first_day = _sessions.get_first_day();
+		m_last_day = m_first_day - 1;
+
+		for( size_t day_index{ 0 }; day_index < day_seconds.size(); ++day_index )
+		{
+			if( day_seconds[ day_index ] > 0 )
+				add_session( m_first_day + static_cast< Utils::DayNumber >( day_index ), day_seconds[ day_index ] );
+		}
+
+		advance( _today );
+	}
+
+	void RateModel::advance( Utils::DayNumber _day )
+	{
+		if( Utils::is_day_valid( m_first_day ) == false || Utils::is_day_valid( _day ) == false )
+			return;
+
+		while( m_last_day < _day )
+		{
+			++m_last_day;
+			++m_nb_days;
+			++m_weekday_days[ _get_weekday( m_last_day ) ];
+
+			m_recent_seconds *= decay;
+			m_recent_weight = m_recent_weight * decay + ( 1.0 - decay );
+		}
+	}
+
+	bool RateModel::add_session( Utils::DayNumber _day, uint32_t _seconds )
+	{
+		if( Utils::is_day_valid( _day ) == false )
+			return true;
+
+		if( Utils::is_day_valid( m_first_day ) == false )
+		{
+			m_first_day = _day;
+			m_last_day = _day - 1;
+		}
+		else if( _day < m_first_day )
+			return false;
+
+		advance( _day );
+
+		m_total_seconds += _seconds;
+		m_weekday_seconds[ _get_weekday( _day ) ] += _seconds;
+		m_recent_seconds += ( 1.0 - decay ) * std::pow( decay, m_last_day - _day ) * _seconds;
+
+		return true;
+	}
+
+	bool RateModel::remove_session( Utils::DayNumber _day, uint32_t _seconds )
+	{
+		if( Utils::is_day_valid( _day ) == false )
+			return true;
+
+		if( Utils::is_day_valid( m_first_day ) == false || _day <= m_first_day || _day > m_last_day )
+			return false;
+
+		const uint32_t weekday{ _get_weekday( _day ) };
+
+		if( m_total_seconds < _seconds || m_weekday_seconds[ weekday ] < _seconds )
+			return false;
+
+		m_total_seconds -= _seconds;
+		m_weekday_seconds[ weekday ] -= _seconds;
+		m_recent_seconds = std::max( m_recent_seconds - ( 1.0 - decay ) * std::pow( decay, m_last_day - _day ) * _seconds, 0.0 );
+
+		return true;
+	}
+
+	double RateModel::get_average_rate() const
+	{
+		return m_nb_days > 0 ? static_cast< double >( m_total_seconds ) / m_nb_days : 0.0;
+	}
+
+	double RateModel::get_recent_rate() const
+	{
+		return m_recent_weight > 0.0 ? m_recent_seconds / m_recent_weight : get_average_rate();
+	}
+
+	double RateModel::get_weekday_rate( uint32_t _weekday ) const
+	{
+		// Less than a week of history, the weekdays that haven't come yet use the average.
+		if( _weekday >= m_weekday_days.size() || m_weekday_days[ _weekday ] == 0 )
+			return get_average_rate();
+
+		return static_cast< double >( m_weekday_seconds[ _weekday ] ) / m_weekday_days[ _weekday ];
+	}
+
+	double RateModel::get_day_rate( Utils::DayNumber _day, uint32_t _days_ahead ) const
+	{
+		const double average{ get_average_rate() };
+
+		if( average <= 0.0 )
+			return 0.0;
+
+		const double recent_difference{ get_recent_rate() / average - 1.0 };
+
+		return get_weekday_rate( _get_weekday( _day ) ) * ( 1.0 + recent_difference * std::pow( decay, _days_ahead ) );
+	}
+
+	uint32_t RateModel::get_remaining_days( Utils::DayNumber _start_day, SplitTime _time ) const
+	{
+		double remaining{ static_cast< double >( std::chrono::duration_cast< std::chrono::seconds >( _time ).count() ) };
+
+		if( remaining <= 0.0 || is_valid() == false || Utils::is_day_valid( _start_day ) == false )
+			return 0;
+
+		// The recent rate is walked day by day while it still weighs on the prediction.
+		const uint32_t recent_days{ static_cast< uint32_t >( std::ceil( half_life * 8.0 / 7.0 ) ) * 7 };
+		const uint32_t days_ahead{ Utils::is_day_valid( m_last_day ) && _start_day > m_last_day ? static_cast< uint32_t >( _start_day - m_last_day ) : 1 };
+
+		for( uint32_t nb_days{ 0 }; nb_days < recent_days; ++nb_days )
+		{
+			remaining -= get_day_rate( _start_day + static_cast< Utils::DayNumber >( nb_days ), days_ahead + nb_days );
+
+			if( remaining <= 0.0 )
+				return nb_days;
+		}
+
+		std::array< double, 7 > rates{};
+		double week_seconds{ 0.0 };
+
+		for( uint32_t weekday{ 0 }; weekday < rates.size(); ++weekday )
+		{
+			rates[ weekday ] = get_weekday_rate( weekday );
+			week_seconds += rates[ weekday ];
+		}
+
+		// After that, whole weeks all play the same time. They're skipped at once and only the last one is walked day by day.
+		uint32_t nb_weeks{ static_cast< uint32_t >( std::min( remaining / week_seconds, static_cast< double >( max_days / 7 ) ) ) };
+
+		if( nb_weeks > 0 && nb_weeks * week_seconds >= remaining )
+			--nb_weeks;
+
+		remaining -= nb_weeks * week_seconds;
+
+		for( uint32_t nb_days{ recent_days + nb_weeks * 7 }; nb_days < max_days; ++nb_days )
+		{
+			remaining -= rates[ _get_weekday( _start_day + static_cast< Utils::DayNumber >( nb_days ) ) ];
+
+			if( remaining <= 0.0 )
+				return nb_days;
+		}
+
+		return max_days;
+	}
+
+	bool RateModel::is_close_to( const RateModel& _other ) const
+	{
+		auto is_close = []( double _value, double _other_value ) { return std::abs( _value - _other_value ) <= 1e-6 * std::max( { 1.0, std::abs( _value ), std::abs( _other_value ) } ); };
+
+		return m_first_day == _other.m_first_day && m_last_day == _other.m_last_day && m_total_seconds == _other.m_total_seconds && m_nb_days == _other.m_nb_days
+			&& m_weekday_seconds == _other.m_weekday_seconds && m_weekday_days == _other.m_weekday_days
+			&& is_close( m_recent_seconds, _other.m_recent_seconds ) && is_close( m_recent_weight, _other.m_recent_weight );
+	}
+
+	uint32_t RateModel::_get_weekday( Utils::DayNumber _day )
+	{
+		return std::chrono::weekday{ std::chrono::sys_days{ std::chrono::days{ _day } } }.c_encoding();
+	}
+}
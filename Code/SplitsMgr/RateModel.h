@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "Game.h"
+#include "SessionTable.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Play time to expect on a future day, from the days since the first session.
+	* Each weekday has its own average, scaled by how much has been played in the last weeks compared to the whole history.
+	* That difference fades away with the same half life as the prediction goes further, far days only depend on their weekday.
+	* The recent rate is an exponentially decayed average, kept as a decayed sum so a session can be added or removed on any day without going through the others.
+	************************************************************************/
+	class RateModel
+	{
+	public:
+		static constexpr double		half_life{ 14.0 };			// Number of days after which a day weighs half as much in the recent rate.
+		static constexpr uint32_t	max_days{ 365 * 100 };		// Predictions stop there, the history barely has any play time.
+
+		void clear();
+		/**
+		* @brief Read the daily totals of the table, the days after the last session until _today are counted as days without play.
+		**/
+		void rebuild( const SessionTable& _sessions, Utils::DayNumber _today );
+		/**
+		* @brief Count the days until the given one, the recent rate decays for each day without sessions.
+		**/
+		void advance( Utils::DayNumber _day );
+		/**
+		* @brief Add the time of a session to its day. Sessions without date aren't part of the daily rates.
+		* @return False if the day is before the first one of the model, it has to be rebuilt to start earlier.
+		**/
+		bool add_session( Utils::DayNumber _day, uint32_t _seconds );
+		/**
+		* @brief Remove the time of a session from its day.
+		* @return False if the session was on the first day, which may not have been played anymore. The model has to be rebuilt then.
+		**/
+		bool remove_session( Utils::DayNumber _day, uint32_t _seconds );
+
+		bool				is_valid() const		{ return m_nb_days > 0 && m_total_seconds > 0; }
+		Utils::DayNumber	get_last_day() const	{ return m_last_day; }
+		double				get_average_rate() const;
+		double				get_recent_rate() const;
+		double				get_weekday_rate( uint32_t _weekday ) const;
+		/**
+		* @brief Seconds to expect on the given day: the average of its weekday, scaled by the recent rate over the average one.
+		* @param _days_ahead Number of days between the last counted day and the predicted one, the recent rate matters less the further it is.
+		**/
+		double				get_day_rate( Utils::DayNumber _day, uint32_t _days_ahead ) const;
+		/**
+		* @brief Number of days after _start_day needed to play the given time, 0 if it can be played on the start day.
+		**/
+		uint32_t			get_remaining_days( Utils::DayNumber _start_day, SplitTime _time ) const;
+
+		/**
+		* @brief Check that two models have counted the same days and times, the decayed rates being compared with a tolerance.
+		**/
+		bool is_close_to( const RateModel& _other ) const;
+
+	private:
+		static uint32_t _get_weekday( Utils::DayNumber _day );
+
+		Utils::DayNumber			m_first_day{ Utils::no_day };
+		Utils::DayNumber			m_last_day{ Utils::no_day };	// Last counted day.
+		uint64_t					m_total_seconds{ 0 };
+		uint32_t					m_nb_days{ 0 };
+
+		std::array< uint64_t, 7 >	m_weekday_seconds{};			// Indexed from sunday.
+		std::array< uint32_t, 7 >	m_weekday_days{};
+
+		double						m_recent_seconds{ 0.0 };		// Sum of the days weighted by their decay since the last day.
+		double						m_recent_weight{ 0.0 };			// Sum of the weights, so the first days of a history aren't underestimated.
+	};
+}
@@ -0,0 +1,132 @@
+#include "RecentWindows.h"
+
+
+namespace SplitsMgr
+{
+	void RecentWindows::clear()
+	{
+		*this = RecentWindows{};
+	}
+
+	void RecentWindows::rebuild( const SessionTable& _sessions, Utils::DayNumber _today )
+	{
+		clear();
+
+		if( _sessions.has_dates() == false )
+		{
+			m_last_day = _today;
+			return;
+		}
+
+		const std::span< const uint32_t > day_seconds{ _sessions.get_day_seconds() };
+		const std::span< const uint32_t > day_sessions{ _sessions.get_day_sessions() };
+		m_last_day = Utils::is_day_valid( _today ) ? std::max( _today, _sessions.get_last_day() ) : _sessions.get_last_day();
+
+		for( size_t day_index{ 0 }; day_index < day_seconds.size(); ++day_index )
+		{
+			const Utils::DayNumber day{ _sessions.get_first_day() + static_cast< Utils::DayNumber >( day_index ) };
+
+			if( day_sessions[ day_index ] == 0 || _is_in_history( day ) == false )
+				continue;
+
+			_get_day( day ) = { day_seconds[ day_index ], day_sessions[ day_index ] };
+			_add_to_windows( day, day_seconds[ day_index ], static_cast< int32_t >( day_sessions[ day_index ] ), 1 );
+		}
+	}
+
+	void RecentWindows::advance( Utils::DayNumber _day )
+	{
+		if( Utils::is_day_valid( _day ) == false )
+			return;
+
+		// Nothing of the history is left after that long, starting over is quicker than going through the days.
+		if( Utils::is_day_valid( m_last_day ) == false || _day - m_last_day >= static_cast< Utils::DayNumber >( history_days ) )
+		{
+			clear();
+			m_last_day = _day;
+			return;
+		}
+
+		while( m_last_day < _day )
+		{
+			++m_last_day;
+
+			for( size_t window{ 0 }; window < nb_windows; ++window )
+			{
+				const Day& leaving_day{ _get_day( m_last_day - static_cast< Utils::DayNumber >( window_days[ window ] ) ) };
+				Totals& totals{ m_totals[ window ] };
+
+				totals.m_seconds -= leaving_day.m_seconds;
+				totals.m_nb_sessions -= leaving_day.m_nb_sessions;
+				totals.m_played_days -= leaving_day.m_nb_sessions > 0 ? 1 : 0;
+			}
+
+			// The slot of the new day was the one of the day that just left the longest window.
+			_get_day( m_last_day ) = Day{};
+		}
+	}
+
+	void RecentWindows::add_session( Utils::DayNumber _day, uint32_t _seconds )
+	{
+		if( Utils::is_day_valid( _day ) == false )
+			return;
+
+		advance( _day );
+
+		if( _is_in_history( _day ) == false )
+			return;
+
+		Day& day{ _get_day( _day ) };
+		const int32_t new_played_day{ day.m_nb_sessions == 0 ? 1 : 0 };
+
+		day.m_seconds += _seconds;
+		++day.m_nb_sessions;
+
+		_add_to_windows( _day, _seconds, 1, new_played_day );
+	}
+
+	bool RecentWindows::remove_session( Utils::DayNumber _day, uint32_t _seconds )
+	{
+		if( Utils::is_day_valid( _day ) == false )
+			return true;
+
+		if( Utils::is_day_valid( m_last_day ) == false || _day > m_last_day )
+			return false;
+
+		if( _is_in_history( _day ) == false )
+			return true;
+
+		Day& day{ _get_day( _day ) };
+
+		if( day.m_nb_sessions == 0 || day.m_seconds < _seconds )
+			return false;
+
+		day.m_seconds -= _seconds;
+		--day.m_nb_sessions;
+
+		_add_to_windows( _day, -static_cast< int64_t >( _seconds ), -1, day.m_nb_sessions == 0 ? -1 : 0 );
+
+		return true;
+	}
+
+	RecentWindows::Day& RecentWindows::_get_day( Utils::DayNumber _day )
+	{
+		const Utils::DayNumber slot{ _day % static_cast< Utils::DayNumber >( history_days ) };
+
+		return m_days[ static_cast< size_t >( slot < 0 ? slot + static_cast< Utils::DayNumber >( history_days ) : slot ) ];
+	}
+
+	void RecentWindows::_add_to_windows( Utils::DayNumber _day, int64_t _seconds, int32_t _nb_sessions, int32_t _played_days )
+	{
+		for( size_t window{ 0 }; window < nb_windows; ++window )
+		{
+			if( m_last_day - _day >= static_cast< Utils::DayNumber >( window_days[ window ] ) )
+				continue;
+
+			Totals& totals{ m_totals[ window ] };
+			totals.m_seconds += static_cast< uint64_t >( _seconds );
+			totals.m_nb_sessions += static_cast< uint32_t >( _nb_sessions );
+			totals.m_played_days += static_cast< uint32_t >( _played_days );
+		}
+	}
+}
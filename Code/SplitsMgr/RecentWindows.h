@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+
+#include "Game.h"
+#include "SessionTable.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Play time, sessions and played days of the last weeks and months, the windows ending on the last counted day.
+	* The daily totals of the longest window are kept in a ring indexed by day number, so a session or a new day only updates the few windows it's in.
+	************************************************************************/
+	class RecentWindows
+	{
+	public:
+		static constexpr std::array< uint32_t, 3 >	window_days{ 7, 30, 90 };
+		static constexpr size_t						nb_windows{ window_days.size() };
+		static constexpr uint32_t					history_days{ window_days.back() };
+
+		struct Totals
+		{
+			SplitTime get_played() const			{ return std::chrono::seconds{ m_seconds }; }
+			SplitTime get_average_session() const	{ return m_nb_sessions > 0 ? get_played() / m_nb_sessions : SplitTime{}; }
+			bool operator==( const Totals& _other ) const = default;
+
+			uint64_t	m_seconds{ 0 };
+			uint32_t	m_nb_sessions{ 0 };
+			uint32_t	m_played_days{ 0 };
+		};
+
+		void clear();
+		/**
+		* @brief Read the daily totals of the table, the windows end on _today or on the last played day if it's after.
+		**/
+		void rebuild( const SessionTable& _sessions, Utils::DayNumber _today );
+		/**
+		* @brief Move the end of the windows to the given day, the days leaving them are removed from their totals.
+		**/
+		void advance( Utils::DayNumber _day );
+		/**
+		* @brief Add a session to its day, the windows move to it if it's after the last counted day. Sessions older than the windows are ignored.
+		**/
+		void add_session( Utils::DayNumber _day, uint32_t _seconds );
+		/**
+		* @brief Remove a session from its day.
+		* @return False if the day doesn't have that session, the windows have to be rebuilt then.
+		**/
+		bool remove_session( Utils::DayNumber _day, uint32_t _seconds );
+
+		const Totals&		get_totals( size_t _window ) const		{ return m_totals[ _window ]; }
+		Utils::DayNumber	get_last_day() const					{ return m_last_day; }
+
+		bool operator==( const RecentWindows& _other ) const = default;
+
+	private:
+		struct Day
+		{
+			bool operator==( const Day& _other ) const = default;
+
+			uint32_t	m_seconds{ 0 };
+			uint32_t	m_nb_sessions{ 0 };
+		};
+
+		bool _is_in_history( Utils::DayNumber _day ) const	{ return Utils::is_day_valid( m_last_day ) && _day <= m_last_day && m_last_day - _day < static_cast< Utils::DayNumber >( history_days ); }
+		Day& _get_day( Utils::DayNumber _day );
+		/**
+		* @brief Add the given values to the totals of every window containing the day, negative ones to remove them.
+		**/
+		void _add_to_windows( Utils::DayNumber _day, int64_t _seconds, int32_t _nb_sessions, int32_t _played_days );
+
+		std::array< Day, history_days >		m_days{};		// Totals of the last days, indexed by day number modulo history_days.
+		std::array< Totals, nb_windows >	m_totals{};
+		Utils::DayNumber					m_last_day{ Utils::no_day };
+	};
+}
@@ -0,0 +1,313 @@
+#include <cstddef>
+
+#include "Reduction.h"
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define SPLITSMGR_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define SPLITSMGR_X86_SIMD 0
+#endif
+
+// MSVC lets any function use the intrinsics, GCC and Clang need the instruction set to be enabled on the functions using them.
+#if defined( _MSC_VER )
+#include <intrin.h>
+#define SPLITSMGR_TARGET( _instructions )
+#else
+#define SPLITSMGR_TARGET( _instructions ) __attribute__( ( target( _instructions ) ) )
+#endif
+
+
+namespace SplitsMgr
+{
+	namespace Reduction
+	{
+		// Splits are two 32 bits values, the seconds being the first one. Kernels read one value every Stride.
+		static constexpr size_t split_stride{ sizeof( Split ) / sizeof( uint32_t ) };
+		static_assert( offsetof( Split, m_seconds ) == 0 && split_stride == 2, "The kernels expect splits to start with their seconds, followed by a single other 32 bits value." );
+
+		template< size_t Stride >
+		static void summarize_scalar( const uint32_t* _values, size_t _begin, size_t _count, Summary& _summary )
+		{
+			for( size_t index{ _begin }; index < _count; ++index )
+			{
+				const uint32_t value{ _values[ index * Stride ] };
+				_summary.m_sum += value;
+
+				if( value < _summary.m_min )
+				{
+					_summary.m_min = value;
+					_summary.m_argmin = static_cast< uint32_t >( index );
+				}
+
+				if( value > _summary.m_max )
+				{
+					_summary.m_max = value;
+					_summary.m_argmax = static_cast< uint32_t >( index );
+				}
+			}
+		}
+
+		/**
+		* @brief Merge the per lane results of a vector kernel. On equal values, the lowest index wins to behave like the scalar kernel.
+		**/
+		static void merge_lanes( const uint32_t* _mins, const uint32_t* _min_indexes, const uint32_t* _maxs, const uint32_t* _max_indexes, size_t _nb_lanes, Summary& _summary )
+		{
+			for( size_t lane{ 0 }; lane < _nb_lanes; ++lane )
+			{
+				if( _mins[ lane ] < _summary.m_min || ( _mins[ lane ] == _summary.m_min && _min_indexes[ lane ] < _summary.m_argmin ) )
+				{
+					_summary.m_min = _mins[ lane ];
+					_summary.m_argmin = _min_indexes[ lane ];
+				}
+
+				if( _maxs[ lane ] > _summary.m_max || ( _maxs[ lane ] == _summary.m_max && _max_indexes[ lane ] < _summary.m_argmax ) )
+				{
+					_summary.m_max = _maxs[ lane ];
+					_summary.m_argmax = _max_indexes[ lane ];
+				}
+			}
+		}
+
+#if SPLITSMGR_X86_SIMD
+		template< size_t Stride >
+		SPLITSMGR_TARGET( "sse4.1" ) static __m128i load_sse41( const uint32_t* _values )
+		{
+			if constexpr( Stride == 1 )
+				return _mm_loadu_si128( reinterpret_cast< const __m128i* >( _values ) );
+			else
+			{
+				// Keeping the first value of each of the 4 splits.
+				const __m128 first_splits{ _mm_castsi128_ps( _mm_loadu_si128( reinterpret_cast< const __m128i* >( _values ) ) ) };
+				const __m128 last_splits{ _mm_castsi128_ps( _mm_loadu_si128( reinterpret_cast< const __m128i* >( _values + 4 ) ) ) };
+
+				return _mm_castps_si128( _mm_shuffle_ps( first_splits, last_splits, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+			}
+		}
+
+		template< size_t Stride >
+		SPLITSMGR_TARGET( "sse4.1" ) static void summarize_sse41( const uint32_t* _values, size_t _count, Summary& _summary )
+		{
+			static constexpr size_t nb_lanes{ 4 };
+			const size_t vector_count{ _count - _count % nb_lanes };
+
+			const __m128i zero{ _mm_setzero_si128() };
+			const __m128i all_ones{ _mm_set1_epi32( -1 ) };
+			const __m128i step{ _mm_set1_epi32( static_cast< int >( nb_lanes ) ) };
+			__m128i indexes{ _mm_setr_epi32( 0, 1, 2, 3 ) };
+			__m128i sums{ zero };
+			__m128i mins{ all_ones };
+			__m128i maxs{ zero };
+			__m128i min_indexes{ zero };
+			__m128i max_indexes{ zero };
+
+			for( size_t index{ 0 }; index < vector_count; index += nb_lanes )
+			{
+				const __m128i values{ load_sse41< Stride >( _values + index * Stride ) };
+
+				// Widening to 64 bits before summing so long lists can't overflow.
+				sums = _mm_add_epi64( sums, _mm_unpacklo_epi32( values, zero ) );
+				sums = _mm_add_epi64( sums, _mm_unpackhi_epi32( values, zero ) );
+
+				// There is no unsigned comparison, but max( a, b ) == a means a >= b.
+				const __m128i lower{ _mm_xor_si128( _mm_cmpeq_epi32( _mm_max_epu32( values, mins ), values ), all_ones ) };
+				const __m128i greater{ _mm_xor_si128( _mm_cmpeq_epi32( _mm_min_epu32( values, maxs ), values ), all_ones ) };
+
+				mins = _mm_blendv_epi8( mins, values, lower );
+				min_indexes = _mm_blendv_epi8( min_indexes, indexes, lower );
+				maxs = _mm_blendv_epi8( maxs, values, greater );
+				max_indexes = _mm_blendv_epi8( max_indexes, indexes, greater );
+
+				indexes = _mm_add_epi32( indexes, step );
+			}
+
+			alignas( 16 ) uint64_t lane_sums[ 2 ];
+			alignas( 16 ) uint32_t lane_mins[ nb_lanes ], lane_min_indexes[ nb_lanes ], lane_maxs[ nb_lanes ], lane_max_indexes[ nb_lanes ];
+			_mm_store_si128( reinterpret_cast< __m128i* >( lane_sums ), sums );
+			_mm_store_si128( reinterpret_cast< __m128i* >( lane_mins ), mins );
+			_mm_store_si128( reinterpret_cast< __m128i* >( lane_min_indexes ), min_indexes );
+			_mm_store_si128( reinterpret_cast< __m128i* >( lane_maxs ), maxs );
+			_mm_store_si128( reinterpret_cast< __m128i* >( lane_max_indexes ), max_indexes );
+
+			if( vector_count > 0 )
+			{
+				_summary.m_sum += lane_sums[ 0 ] + lane_sums[ 1 ];
+				merge_lanes( lane_mins, lane_min_indexes, lane_maxs, lane_max_indexes, nb_lanes, _summary );
+			}
+
+			summarize_scalar< Stride >( _values, vector_count, _count, _summary );
+		}
+
+		template< size_t Stride >
+		SPLITSMGR_TARGET( "avx2" ) static __m256i load_avx2( const uint32_t* _values )
+		{
+			if constexpr( Stride == 1 )
+				return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( _values ) );
+			else
+			{
+				// Keeping the first value of each of the 8 splits. The shuffle works on 128 bits halves so the 64 bits blocks have to be put back in order.
+				const __m256 first_splits{ _mm256_castsi256_ps( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( _values ) ) ) };
+				const __m256 last_splits{ _mm256_castsi256_ps( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( _values + 8 ) ) ) };
+				const __m256i shuffled{ _mm256_castps_si256( _mm256_shuffle_ps( first_splits, last_splits, _MM_SHUFFLE( 2, 0, 2, 0 ) ) ) };
+
+				return _mm256_permute4x64_epi64( shuffled, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+			}
+		}
+
+		template< size_t Stride >
+		SPLITSMGR_TARGET( "avx2" ) static void summarize_avx2( const uint32_t* _values, size_t _count, Summary& _summary )
+		{
+			static constexpr size_t nb_lanes{ 8 };
+			const size_t vector_count{ _count - _count % nb_lanes };
+
+			const __m256i zero{ _mm256_setzero_si256() };
+			const __m256i all_ones{ _mm256_set1_epi32( -1 ) };
+			const __m256i step{ _mm256_set1_epi32( static_cast< int >( nb_lanes ) ) };
+			__m256i indexes{ _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) };
+			__m256i sums{ zero };
+			__m256i mins{ all_ones };
+			__m256i maxs{ zero };
+			__m256i min_indexes{ zero };
+			__m256i max_indexes{ zero };
+
+			for( size_t index{ 0 }; index < vector_count; index += nb_lanes )
+			{
+				const __m256i values{ load_avx2< Stride >( _values + index * Stride ) };
+
+				sums = _mm256_add_epi64( sums, _mm256_cvtepu32_epi64( _mm256_castsi256_si128( values ) ) );
+				sums = _mm256_add_epi64( sums, _mm256_cvtepu32_epi64( _mm256_extracti128_si256( values, 1 ) ) );
+
+				const __m256i lower{ _mm256_xor_si256( _mm256_cmpeq_epi32( _mm256_max_epu32( values, mins ), values ), all_ones ) };
+				const __m256i greater{ _mm256_xor_si256( _mm256_cmpeq_epi32( _mm256_min_epu32( values, maxs ), values ), all_ones ) };
+
+				mins = _mm256_blendv_epi8( mins, values, lower );
+				min_indexes = _mm256_blendv_epi8( min_indexes, indexes, lower );
+				maxs = _mm256_blendv_epi8( maxs, values, greater );
+				max_indexes = _mm256_blendv_epi8( max_indexes, indexes, greater );
+
+				indexes = _mm256_add_epi32( indexes, step );
+			}
+
+			alignas( 32 ) uint64_t lane_sums[ 4 ];
+			alignas( 32 ) uint32_t lane_mins[ nb_lanes ], lane_min_indexes[ nb_lanes ], lane_maxs[ nb_lanes ], lane_max_indexes[ nb_lanes ];
+			_mm256_store_si256( reinterpret_cast< __m256i* >( lane_sums ), sums );
+			_mm256_store_si256( reinterpret_cast< __m256i* >( lane_mins ), mins );
+			_mm256_store_si256( reinterpret_cast< __m256i* >( lane_min_indexes ), min_indexes );
+			_mm256_store_si256( reinterpret_cast< __m256i* >( lane_maxs ), maxs );
+			_mm256_store_si256( reinterpret_cast< __m256i* >( lane_max_indexes ), max_indexes );
+
+			if( vector_count > 0 )
+			{
+				_summary.m_sum += lane_sums[ 0 ] + lane_sums[ 1 ] + lane_sums[ 2 ] + lane_sums[ 3 ];
+				merge_lanes( lane_mins, lane_min_indexes, lane_maxs, lane_max_indexes, nb_lanes, _summary );
+			}
+
+			summarize_scalar< Stride >( _values, vector_count, _count, _summary );
+		}
+#endif
+
+		static Instructions detect_instructions()
+		{
+#if SPLITSMGR_X86_SIMD
+	#if defined( _MSC_VER )
+			int cpu_infos[ 4 ]{};
+			__cpuid( cpu_infos, 0 );
+			const int max_leaf{ cpu_infos[ 0 ] };
+
+			__cpuid( cpu_infos, 1 );
+			const bool sse41{ ( cpu_infos[ 2 ] & ( 1 << 19 ) ) != 0 };
+			const bool os_saves_avx{ ( cpu_infos[ 2 ] & ( 1 << 27 ) ) != 0 && ( cpu_infos[ 2 ] & ( 1 << 28 ) ) != 0 && ( _xgetbv( 0 ) & 0x6 ) == 0x6 };
+			bool avx2{ false };
+
+			if( max_leaf >= 7 && os_saves_avx )
+			{
+				__cpuidex( cpu_infos, 7, 0 );
+				avx2 = ( cpu_infos[ 1 ] & ( 1 << 5 ) ) != 0;
+			}
+	#else
+			__builtin_cpu_init();
+			const bool sse41{ __builtin_cpu_supports( "sse4.1" ) != 0 };
+			const bool avx2{ __builtin_cpu_supports( "avx2" ) != 0 };
+	#endif
+			if( avx2 )
+				return Instructions::avx2;
+
+			if( sse41 )
+				return Instructions::sse41;
+#endif
+			return Instructions::scalar;
+		}
+
+		template< size_t Stride >
+		static Summary summarize_values( const uint32_t* _values, size_t _count, Instructions _instructions )
+		{
+			Summary summary{};
+			summary.m_count = static_cast< uint32_t >( _count );
+
+			switch( _instructions )
+			{
+#if SPLITSMGR_X86_SIMD
+				case Instructions::avx2:
+				{
+					summarize_avx2< Stride >( _values, _count, summary );
+					break;
+				}
+				case Instructions::sse41:
+				{
+					summarize_sse41< Stride >( _values, _count, summary );
+					break;
+				}
+#endif
+				default:
+				{
+					summarize_scalar< Stride >( _values, 0, _count, summary );
+					break;
+				}
+			};
+
+			return summary;
+		}
+
+		Summary summarize( std::span< const uint32_t > _seconds )
+		{
+			return summarize( _seconds, get_instructions() );
+		}
+
+		Summary summarize( std::span< const Split > _splits )
+		{
+			return summarize( _splits, get_instructions() );
+		}
+
+		Summary summarize( std::span< const uint32_t > _seconds, Instructions _instructions )
+		{
+			return summarize_values< 1 >( _seconds.data(), _seconds.size(), _instructions );
+		}
+
+		Summary summarize( std::span< const Split > _splits, Instructions _instructions )
+		{
+			return summarize_values< split_stride >( _splits.empty() ? nullptr : &_splits.front().m_seconds, _splits.size(), _instructions );
+		}
+
+		Instructions get_instructions()
+		{
+			static const Instructions instructions{ detect_instructions() };
+
+			return instructions;
+		}
+
+		const char* get_instructions_str( Instructions _instructions )
+		{
+			switch( _instructions )
+			{
+				case Instructions::scalar:
+					return "Scalar";
+				case Instructions::sse41:
+					return "SSE4.1";
+				case Instructions::avx2:
+					return "AVX2";
+				default:
+					return "COUNT";
+			};
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <span>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	namespace Reduction
+	{
+		/**
+		* @brief Instruction sets the reduction kernels can use, the best one available on the CPU is picked at runtime.
+		**/
+		enum class Instructions
+		{
+			scalar,
+			sse41,
+			avx2,
+			COUNT
+		};
+
+		/**
+		* @brief Everything the stats need to know about a set of session durations, computed in a single pass.
+		**/
+		struct Summary
+		{
+			SplitTime get_sum() const		{ return std::chrono::seconds{ m_sum }; }
+			SplitTime get_min() const		{ return m_count > 0 ? std::chrono::seconds{ m_min } : SplitTime{}; }
+			SplitTime get_max() const		{ return std::chrono::seconds{ m_max }; }
+			SplitTime get_average() const	{ return m_count > 0 ? std::chrono::seconds{ m_sum / m_count } : SplitTime{}; }
+
+			uint32_t m_count{ 0 };
+			uint64_t m_sum{ 0 };
+			uint32_t m_min{ UINT32_MAX };
+			uint32_t m_max{ 0 };
+			uint32_t m_argmin{ 0 };		// Index of the first shortest session.
+			uint32_t m_argmax{ 0 };		// Index of the first longest session.
+		};
+
+		/**
+		* @brief Count, sum, min and max of durations in seconds, like the ones of the sessions table.
+		**/
+		Summary summarize( std::span< const uint32_t > _seconds );
+		/**
+		* @brief Count, sum, min and max of the durations of the given splits.
+		**/
+		Summary summarize( std::span< const Split > _splits );
+		/**
+		* @brief Same as summarize, but forcing the instruction set. Used to compare the kernels with each other.
+		**/
+		Summary summarize( std::span< const uint32_t > _seconds, Instructions _instructions );
+		Summary summarize( std::span< const Split > _splits, Instructions _instructions );
+
+		Instructions get_instructions();
+		const char* get_instructions_str( Instructions _instructions );
+	}
+}
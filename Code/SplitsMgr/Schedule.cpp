@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include "Schedule.h"
+
+
+namespace SplitsMgr
+{
+	void Schedule::clear()
+	{
+		m_remaining_seconds.clear();
+		m_remaining_before.clear();
+		m_entries.clear();
+		m_today = Utils::no_day;
+		m_daily_seconds = 0;
+	}
+
+	void Schedule::update( const Games& _games, uint32_t _first_changed_slot, Utils::DayNumber _today, SplitTime _daily_time )
+	{
+		const uint64_t daily_seconds{ _daily_time > SplitTime{} ? static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::seconds >( _daily_time ).count() ) : 0 };
+
+		if( _games.size() != m_entries.size() || _today != m_today || daily_seconds != m_daily_seconds )
+		{
+			m_remaining_seconds.resize( _games.size() );
+			m_remaining_before.resize( _games.size() );
+			m_entries.resize( _games.size() );
+			m_today = _today;
+			m_daily_seconds = daily_seconds;
+			_first_changed_slot = 0;
+		}
+
+		if( _first_changed_slot >= _games.size() )
+			return;
+
+		uint64_t remaining_before{ _first_changed_slot > 0 ? m_remaining_before[ _first_changed_slot - 1 ] + m_remaining_seconds[ _first_changed_slot - 1 ] : 0 };
+
+		for( uint32_t slot{ _first_changed_slot }; slot < _games.size(); ++slot )
+		{
+			const Game& game{ _games[ slot ] };
+			Entry& entry{ m_entries[ slot ] };
+			uint64_t remaining{ 0 };
+
+			if( game.is_finished() == false && game.get_played() < game.get_estimate() )
+				remaining = static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::seconds >( game.get_estimate() - game.get_played() ).count() );
+
+			m_remaining_seconds[ slot ] = remaining;
+			m_remaining_before[ slot ] = remaining_before;
+
+			if( game.is_finished() )
+			{
+				entry.m_start_day = game.get_begin_day();
+				entry.m_end_day = game.has_sessions() ? game.get_splits().back().m_day : Utils::no_day;
+				entry.m_projected = false;
+			}
+			else
+			{
+				// A started game keeps the day it has been started on, only its end is projected.
+				entry.m_start_day = Utils::is_day_valid( game.get_begin_day() ) ? game.get_begin_day() : _get_day( remaining_before, false );
+				entry.m_end_day = _get_day( remaining_before + remaining, true );
+				entry.m_projected = true;
+
+				if( Utils::is_day_valid( entry.m_start_day ) && Utils::is_day_valid( entry.m_end_day ) )
+					entry.m_end_day = std::max( entry.m_end_day, entry.m_start_day );
+			}
+
+			remaining_before += remaining;
+		}
+	}
+
+	Utils::DayNumber Schedule::_get_day( uint64_t _seconds, bool _ending ) const
+	{
+		if( m_daily_seconds == 0 || Utils::is_day_valid( m_today ) == false )
+			return Utils::no_day;
+
+		// A game starts on the day the time before it is reached, and ends on the last day needed to play all of its time.
+		if( _ending == false )
+			return Utils::add_days_to_date( m_today, static_cast< uint32_t >( _seconds / m_daily_seconds ) );
+
+		if( _seconds == 0 )
+			return m_today;
+
+		return Utils::add_days_to_date( m_today, static_cast< uint32_t >( ( _seconds + m_daily_seconds - 1 ) / m_daily_seconds - 1 ) );
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Projected calendar of the list: the day each game starts and ends on, playing the games in list order at the average play time per day.
+	* Played games keep the day of their first session, the others start when the time left on the games before them has been played.
+	* The time left before each game is a running sum, so a change on a game only moves the games after it.
+	************************************************************************/
+	class Schedule
+	{
+	public:
+		struct Entry
+		{
+			Utils::DayNumber	m_start_day{ Utils::no_day };
+			Utils::DayNumber	m_end_day{ Utils::no_day };
+			bool				m_projected{ false };		// False for finished games, which have been played on these days.
+		};
+
+		void clear();
+		/**
+		* @brief Compute the schedule again from the given position, the games before it keep their days.
+		* Everything is computed again if the day, the time played per day or the number of games changed, as all the games move then.
+		* @param _first_changed_slot Position of the first game whose estimate, sessions or state changed.
+		* @param _today The day the projection starts from.
+		* @param _daily_time Average time played per day, days without sessions included.
+		**/
+		void update( const Games& _games, uint32_t _first_changed_slot, Utils::DayNumber _today, SplitTime _daily_time );
+
+		std::span< const Entry >	get_entries() const						{ return m_entries; }
+		const Entry*				get_entry( uint32_t _slot ) const		{ return _slot < m_entries.size() ? &m_entries[ _slot ] : nullptr; }
+
+	private:
+		/**
+		* @brief Day the given amount of remaining time is reached, the first day being today.
+		**/
+		Utils::DayNumber _get_day( uint64_t _seconds, bool _ending ) const;
+
+		std::vector< uint64_t >	m_remaining_seconds;		// Time left to play on each game.
+		std::vector< uint64_t >	m_remaining_before;			// Time left to play on all the games before each one.
+		std::vector< Entry >	m_entries;
+
+		Utils::DayNumber		m_today{ Utils::no_day };
+		uint64_t				m_daily_seconds{ 0 };
+	};
+}
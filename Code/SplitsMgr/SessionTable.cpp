@@ -0,0 +1,228 @@
+#include <algorithm>
+
+#include "SessionTable.h"
+
+
+namespace SplitsMgr
+{
+	void SessionTable::clear()
+	{
+		m_seconds.clear();
+		m_days.clear();
+		m_game_ids.clear();
+		m_ordinals.clear();
+		m_game_ranges.clear();
+		m_day_sessions.clear();
+		m_day_seconds.clear();
+
+		m_first_day = Split::no_date;
+		m_last_day = Split::no_date;
+	}
+
+	/**
+	* @brief Fill the columns with the sessions of the given games. The game id of a session is the index of its game in the list.
+	**/
+	void SessionTable::rebuild( const Games& _games )
+	{
+		clear();
+
+		size_t nb_sessions{ 0 };
+
+		for( const Game& game : _games )
+			nb_sessions += game.get_splits().size();
+
+		m_seconds.reserve( nb_sessions );
+		m_days.reserve( nb_sessions );
+		m_game_ids.reserve( nb_sessions );
+		m_ordinals.reserve( nb_sessions );
+		m_game_ranges.reserve( _games.size() );
+
+		for( uint32_t game_id{ 0 }; game_id < _games.size(); ++game_id )
+		{
+			const Splits& splits{ _games[ game_id ].get_splits() };
+			GameRange range{ static_cast< uint32_t >( m_seconds.size() ) };
+
+			for( uint32_t split_index{ 0 }; split_index < splits.size(); ++split_index )
+			{
+				const Split& split{ splits[ split_index ] };
+
+				m_seconds.push_back( split.m_seconds );
+				m_days.push_back( split.m_day );
+				m_game_ids.push_back( game_id );
+				m_ordinals.push_back( split_index + 1 );
+
+				if( split.m_day == Split::no_date )
+					continue;
+
+				if( m_first_day == Split::no_date || split.m_day < m_first_day )
+					m_first_day = split.m_day;
+
+				if( m_last_day == Split::no_date || split.m_day > m_last_day )
+					m_last_day = split.m_day;
+			}
+
+			range.m_end = static_cast< uint32_t >( m_seconds.size() );
+			m_game_ranges.push_back( range );
+		}
+
+		if( has_dates() == false )
+			return;
+
+		m_day_sessions.assign( static_cast< size_t >( m_last_day - m_first_day + 1 ), 0 );
+		m_day_seconds.assign( m_day_sessions.size(), 0 );
+
+		for( size_t row{ 0 }; row < m_days.size(); ++row )
+		{
+			if( m_days[ row ] == Split::no_date )
+				continue;
+
+			const size_t day_index{ static_cast< size_t >( m_days[ row ] - m_first_day ) };
+
+			++m_day_sessions[ day_index ];
+			m_day_seconds[ day_index ] += m_seconds[ row ];
+		}
+	}
+
+	void SessionTable::add_session( uint32_t _game_id, uint32_t _seconds, int32_t _day )
+	{
+		GameRange& range{ m_game_ranges[ _game_id ] };
+		const size_t row{ range.m_end };
+
+		m_seconds.insert( m_seconds.begin() + row, _seconds );
+		m_days.insert( m_days.begin() + row, _day );
+		m_game_ids.insert( m_game_ids.begin() + row, _game_id );
+		m_ordinals.insert( m_ordinals.begin() + row, range.size() + 1 );
+
+		++range.m_end;
+
+		// The sessions of the next games move down one row.
+		for( size_t game_id{ _game_id + 1u }; game_id < m_game_ranges.size(); ++game_id )
+		{
+			++m_game_ranges[ game_id ].m_begin;
+			++m_game_ranges[ game_id ].m_end;
+		}
+
+		_add_to_day( _day, _seconds );
+	}
+
+	void SessionTable::edit_session( uint32_t _game_id, uint32_t _session_index, uint32_t _seconds, int32_t _day )
+	{
+		const size_t row{ m_game_ranges[ _game_id ].m_begin + _session_index };
+
+		_remove_from_day( m_days[ row ], m_seconds[ row ] );
+
+		m_seconds[ row ] = _seconds;
+		m_days[ row ] = _day;
+
+		_add_to_day( _day, _seconds );
+	}
+
+	void SessionTable::remove_session( uint32_t _game_id, uint32_t _session_index )
+	{
+		GameRange& range{ m_game_ranges[ _game_id ] };
+		const size_t row{ range.m_begin + _session_index };
+
+		_remove_from_day( m_days[ row ], m_seconds[ row ] );
+
+		m_seconds.erase( m_seconds.begin() + row );
+		m_days.erase( m_days.begin() + row );
+		m_game_ids.erase( m_game_ids.begin() + row );
+		m_ordinals.erase( m_ordinals.begin() + row );
+
+		// The next sessions of the same game move up one place in it.
+		for( size_t next_row{ row }; next_row < range.m_end - 1; ++next_row )
+			--m_ordinals[ next_row ];
+
+		--range.m_end;
+
+		for( size_t game_id{ _game_id + 1u }; game_id < m_game_ranges.size(); ++game_id )
+		{
+			--m_game_ranges[ game_id ].m_begin;
+			--m_game_ranges[ game_id ].m_end;
+		}
+	}
+
+	std::span< const uint32_t > SessionTable::get_game_seconds( uint32_t _game_id ) const
+	{
+		const GameRange& range{ m_game_ranges[ _game_id ] };
+
+		return std::span< const uint32_t >{ m_seconds }.subspan( range.m_begin, range.size() );
+	}
+
+	std::span< const int32_t > SessionTable::get_game_days( uint32_t _game_id ) const
+	{
+		const GameRange& range{ m_game_ranges[ _game_id ] };
+
+		return std::span< const int32_t >{ m_days }.subspan( range.m_begin, range.size() );
+	}
+
+	void SessionTable::_add_to_day( int32_t _day, uint32_t _seconds )
+	{
+		if( _day == Split::no_date )
+			return;
+
+		if( has_dates() == false )
+		{
+			m_first_day = _day;
+			m_last_day = _day;
+			m_day_sessions.assign( 1, 0 );
+			m_day_seconds.assign( 1, 0 );
+		}
+		else if( _day < m_first_day )
+		{
+			const size_t nb_new_days{ static_cast< size_t >( m_first_day - _day ) };
+			m_day_sessions.insert( m_day_sessions.begin(), nb_new_days, 0 );
+			m_day_seconds.insert( m_day_seconds.begin(), nb_new_days, 0 );
+			m_first_day = _day;
+		}
+		else if( _day > m_last_day )
+		{
+			m_day_sessions.resize( m_day_sessions.size() + static_cast< size_t >( _day - m_last_day ), 0 );
+			m_day_seconds.resize( m_day_sessions.size(), 0 );
+			m_last_day = _day;
+		}
+
+		const size_t day_index{ static_cast< size_t >( _day - m_first_day ) };
+		++m_day_sessions[ day_index ];
+		m_day_seconds[ day_index ] += _seconds;
+	}
+
+	void SessionTable::_remove_from_day( int32_t _day, uint32_t _seconds )
+	{
+		if( _day == Split::no_date )
+			return;
+
+		const size_t day_index{ static_cast< size_t >( _day - m_first_day ) };
+		--m_day_sessions[ day_index ];
+		m_day_seconds[ day_index ] -= _seconds;
+
+		// The first and last days stay played ones, so the range shrinks when one of them doesn't have sessions anymore.
+		size_t nb_empty_first_days{ 0 };
+
+		while( nb_empty_first_days < m_day_sessions.size() && m_day_sessions[ nb_empty_first_days ] == 0 )
+			++nb_empty_first_days;
+
+		if( nb_empty_first_days == m_day_sessions.size() )
+		{
+			m_day_sessions.clear();
+			m_day_seconds.clear();
+			m_first_day = Split::no_date;
+			m_last_day = Split::no_date;
+			return;
+		}
+
+		if( nb_empty_first_days > 0 )
+		{
+			m_day_sessions.erase( m_day_sessions.begin(), m_day_sessions.begin() + nb_empty_first_days );
+			m_day_seconds.erase( m_day_seconds.begin(), m_day_seconds.begin() + nb_empty_first_days );
+			m_first_day += static_cast< int32_t >( nb_empty_first_days );
+		}
+
+		while( m_day_sessions.back() == 0 )
+		{
+			m_day_sessions.pop_back();
+			m_day_seconds.pop_back();
+			--m_last_day;
+		}
+	}
+}
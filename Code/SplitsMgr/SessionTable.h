@@ -0,0 +1,88 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Game.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Sessions of all the games of the list stored column by column, in list order.
+	* Each game is a contiguous range of rows, so stats can run tight loops on a single column without going through the games.
+	************************************************************************/
+	class SessionTable
+	{
+	public:
+		struct GameRange
+		{
+			uint32_t size() const	{ return m_end - m_begin; }
+			bool empty() const		{ return m_end == m_begin; }
+			bool operator==( const GameRange& _other ) const = default;
+
+			uint32_t m_begin{ 0 };
+			uint32_t m_end{ 0 };
+		};
+
+		void clear();
+		/**
+		* @brief Fill the columns with the sessions of the given games. The game id of a session is the index of its game in the list.
+		**/
+		void rebuild( const Games& _games );
+		/**
+		* @brief Add a session at the end of a game, the columns and daily totals are updated without going through the other sessions.
+		* @param _game_id Index of the game in the list.
+		**/
+		void add_session( uint32_t _game_id, uint32_t _seconds, int32_t _day );
+		/**
+		* @brief Change the duration and day of a session in place, the columns and daily totals are updated without going through the other sessions.
+		* @param _game_id Index of the game in the list.
+		* @param _session_index Index of the session in its game, starting at 0.
+		**/
+		void edit_session( uint32_t _game_id, uint32_t _session_index, uint32_t _seconds, int32_t _day );
+		/**
+		* @brief Remove a session from the columns and daily totals. The rows of the sessions after it are shifted back.
+		* @param _game_id Index of the game in the list.
+		* @param _session_index Index of the session in its game, starting at 0.
+		**/
+		void remove_session( uint32_t _game_id, uint32_t _session_index );
+
+		size_t		get_nb_sessions() const							{ return m_seconds.size(); }
+		size_t		get_nb_games() const							{ return m_game_ranges.size(); }
+		int32_t		get_first_day() const							{ return m_first_day; }
+		int32_t		get_last_day() const							{ return m_last_day; }
+		bool		has_dates() const								{ return m_first_day != Split::no_date; }
+
+		std::span< const uint32_t >	get_seconds() const				{ return m_seconds; }
+		std::span< const int32_t >	get_days() const				{ return m_days; }
+		std::span< const uint32_t >	get_game_ids() const			{ return m_game_ids; }
+		std::span< const uint32_t >	get_ordinals() const			{ return m_ordinals; }
+		std::span< const uint32_t >	get_day_sessions() const		{ return m_day_sessions; }
+		std::span< const uint32_t >	get_day_seconds() const			{ return m_day_seconds; }
+
+		GameRange get_game_range( uint32_t _game_id ) const			{ return m_game_ranges[ _game_id ]; }
+		std::span< const uint32_t > get_game_seconds( uint32_t _game_id ) const;
+		std::span< const int32_t > get_game_days( uint32_t _game_id ) const;
+
+		bool operator==( const SessionTable& _other ) const = default;
+
+	private:
+		void _add_to_day( int32_t _day, uint32_t _seconds );
+		void _remove_from_day( int32_t _day, uint32_t _seconds );
+
+		std::vector< uint32_t >		m_seconds;			// Duration of each session, in seconds.
+		std::vector< int32_t >		m_days;				// Day number of each session, Split::no_date if it hasn't any.
+		std::vector< uint32_t >		m_game_ids;			// Index of the game of each session in the list.
+		std::vector< uint32_t >		m_ordinals;			// Index of the session in its game, starting at 1.
+
+		std::vector< GameRange >	m_game_ranges;		// Rows of each game, indexed by game id.
+
+		// Number of sessions and played seconds of every day from the first to the last played one, indexed by day number minus the first day.
+		std::vector< uint32_t >		m_day_sessions;
+		std::vector< uint32_t >		m_day_seconds;
+
+		int32_t						m_first_day{ Split::no_date };
+		int32_t						m_last_day{ Split::no_date };
+	};
+}
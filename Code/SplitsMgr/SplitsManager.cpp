@@ -1,14 +1,23 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
 #include <format>
+#include <unordered_map>
 
 #include <SFML/Graphics/Texture.hpp>
 
 #include <Externals/json/json.h>
+#include <tinyXML2/tinyxml2.h>
 
 #include <FZN/Managers/FazonCore.h>
 #include <FZN/Tools/Logging.h>
 #include <FZN/Tools/Tools.h>
 #include <FZN/UI/ImGui.h>
 
+#include "AllocationTracker.h"
+#include "CsvReader.h"
+#include "LssReader.h"
 #include "SplitsManager.h"
 #include "Utils.h"
 
@@ -25,8 +34,7 @@ namespace SplitsMgr
 	{
 		g_pFZN_Core->RemoveCallback( this, &SplitsManager::on_event, fzn::DataCallbackType::Event );
 
-		for( Game& game : m_games )
-			g_pFZN_Core->RemoveCallback( &game, &Game::on_event, fzn::DataCallbackType::Event );
+		_remove_games_callbacks();
 	}
 
 	void SplitsManager::display_left_panel()
@@ -34,6 +42,7 @@ namespace SplitsMgr
 		if( m_games.empty() )
 			return;
 
+		SPLITSMGR_ALLOCATION_SCOPE( "Games list" );
 		ImGui::PushStyleColor( ImGuiCol_Separator, ImGui_fzn::color::white );
 
 		ImGui::BeginChild( "Games" );
@@ -68,15 +77,16 @@ namespace SplitsMgr
 			timer_color = ImGui_fzn::color::gray;
 
 		if( g_pFZN_InputMgr->IsActionPressed( "Refresh" ) )
-			m_stats.refresh( m_games );
+			_update_run_stats();
+
+		SPLITSMGR_ALLOCATION_SCOPE( "Right panel" );
 
 		ImGui::NewLine();
-		std::string title = m_title;
 		ImGui::SetWindowFontScale( 2.f );
-		ImVec2 text_size = ImGui::CalcTextSize( title.c_str() );
+		ImVec2 text_size = ImGui::CalcTextSize( m_title.c_str() );
 		ImGui::NewLine();
 		ImGui::SameLine( ImGui::GetContentRegionAvail().x * 0.5f - text_size.x * 0.5f );
-		ImGui::Text( title.c_str() );
+		ImGui::TextUnformatted( m_title.c_str() );
 		ImGui::SetWindowFontScale( 1.f );
 		ImGui::NewLine();
 
@@ -102,13 +112,13 @@ namespace SplitsMgr
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Delta:" );
 
 			ImGui::TableNextColumn();
-			ImGui::Text( Utils::time_to_str( m_estimate ).c_str() );
-			ImGui::TextColored( timer_color, Utils::time_to_str( m_played + m_chrono.get_time() ).c_str() );
+			ImGui::TextUnformatted( Utils::format_time( m_estimate ).c_str() );
+			ImGui::TextColored( timer_color, "%s", Utils::format_time( m_played + m_chrono.get_time() ).c_str() );
 
 			if( over_estimate )
-				ImGui::TextColored( timer_color, Utils::time_to_str( m_delta + game_delta ).c_str() );
+				ImGui::TextColored( timer_color, "%s", Utils::format_time( m_delta + game_delta ).c_str() );
 			else
-				ImGui::Text( Utils::time_to_str( m_delta ).c_str() );
+				ImGui::TextUnformatted( Utils::format_time( m_delta ).c_str() );
 
 			ImGui::TableNextColumn();
 			ImGui::TextColored( ImGui_fzn::color::light_yellow, "Rem. Time:" );
@@ -117,19 +127,21 @@ namespace SplitsMgr
 			ImGui::TableNextColumn();
 
 			if( over_estimate )
-				ImGui::TextColored( timer_color, Utils::time_to_str( m_remaining_time + previous_delta + game_delta ).c_str() );
+				ImGui::TextColored( timer_color, "%s", Utils::format_time( m_remaining_time + previous_delta + game_delta ).c_str() );
 			else
-				ImGui::TextColored( timer_color, Utils::time_to_str( m_remaining_time - m_chrono.get_time() ).c_str() );
+				ImGui::TextColored( timer_color, "%s", Utils::format_time( m_remaining_time - m_chrono.get_time() ).c_str() );
 
 			if( over_estimate )
-				ImGui::TextColored( timer_color, Utils::time_to_str( m_estimated_final_time + game_delta ).c_str() );
+				ImGui::TextColored( timer_color, "%s", Utils::format_time( m_estimated_final_time + game_delta ).c_str() );
 			else
-				ImGui::Text( Utils::time_to_str( m_estimated_final_time ).c_str() );
+				ImGui::TextUnformatted( Utils::format_time( m_estimated_final_time ).c_str() );
 
 			ImGui::EndTable();
 		}
 
-		m_stats.display();
+		// Only the days that left the windows since the last frame are removed from them.
+		m_recent_windows.advance( Utils::today() );
+		m_stats.display( m_games, m_recent_windows, m_streaks );
 	}
 
 	void SplitsManager::on_event()
@@ -154,6 +166,12 @@ namespace SplitsMgr
 					m_finished_game = split_event->m_game_event.m_game;
 				break;
 			}
+			case Event::Type::session_edited:
+			case Event::Type::session_deleted:
+			{
+				_on_game_session_changed( split_event->m_game_event, split_event->m_type == Event::Type::session_deleted );
+				break;
+			}
 			case Event::Type::new_current_game_selected:
 			{
 				if( m_current_game != nullptr )
@@ -164,16 +182,37 @@ namespace SplitsMgr
 			}
 			case Event::Type::game_estimate_changed:
 			{
-				_update_run_stats();
+				// The sessions didn't change so the table is kept, and the schedule is only computed again from the changed game.
+				if( split_event->m_game_event.m_game != nullptr )
+					_refresh_run_stats( split_event->m_game_event.m_game->get_list_slot() );
+				else
+					_update_run_stats();
 				break;
 			}
 			case Event::Type::game_list_generated:
 			{
 				close_game_list();
 				m_games = *split_event->m_game_event.m_games;
-				m_current_game = split_event->m_game_event.m_game;
+				_add_games_callbacks();
+
+				// The event points to the current game of the list creator, ours is the copy at the same position.
+				if( split_event->m_game_event.m_game != nullptr )
+					m_current_game = &m_games[ split_event->m_game_event.m_game - split_event->m_game_event.m_games->data() ];
+
+				_update_list_positions();
 				_update_run_stats();
-				m_stats.refresh( m_games );
+				break;
+			}
+			case Event::Type::game_moved:
+			{
+				move_game( split_event->m_game_event.m_list_slot, split_event->m_game_event.m_target_slot );
+				break;
+			}
+			case Event::Type::game_inserted:
+			{
+				// Copied before inserting, the game holding the description may move with the insertion.
+				const Game::Desc inserted_game{ split_event->m_game_event.m_game->get_inserted_game() };
+				insert_game( split_event->m_game_event.m_target_slot, inserted_game );
 				break;
 			}
 		};
@@ -184,9 +223,18 @@ namespace SplitsMgr
 	*/
 	void SplitsManager::close_game_list()
 	{
+		_remove_games_callbacks();
 		m_games.clear();
+		m_list_pool.release();
+		m_list_arena.release();
+		m_list_index.clear();
+		m_sessions.clear();
+		m_rate_model.clear();
+		m_recent_windows.clear();
+		m_streaks.clear();
 		m_stats.reset();
 		m_current_game = nullptr;
+		m_finished_game = nullptr;
 	}
 
 	/**
@@ -207,39 +255,226 @@ namespace SplitsMgr
 		auto root = Json::Value{};
 		file >> root;
 
+		_remove_games_callbacks();
 		m_games.clear();
+		m_list_pool.release();
+		m_list_arena.release();
 		m_games.reserve( 100 );
+		m_current_game = nullptr;
+		m_finished_game = nullptr;
 
 		m_title = root[ "Title" ].asString();
 
-		Json::Value games = root[ "Games" ];
-		Json::Value::iterator it_game = games.begin();
+		const Json::Value& games = root[ "Games" ];
 		Utils::ParsingInfos parsing_infos{};
+		parsing_infos.m_resource = &m_list_pool;
 		bool is_current_game{ false };
+		size_t current_game_slot{ SIZE_MAX };
 
-		for( Json::Value::iterator it_game = games.begin(); it_game != games.end(); ++it_game )
+		for( Json::Value::const_iterator it_game = games.begin(); it_game != games.end(); ++it_game )
 		{
-			auto game = Game{};
+			auto game = Game{ parsing_infos.m_resource };
 			is_current_game = game.read( *it_game, parsing_infos );
 
 			m_games.emplace_back( std::move( game ) );
-			g_pFZN_Core->AddCallback( &m_games.back(), &Game::on_event, fzn::DataCallbackType::Event );
 
 			if( is_current_game )
+				current_game_slot = m_games.size() - 1;
+		}
+
+		// Addresses are only taken once all the games are read, the vector can grow past its reserved size.
+		_add_games_callbacks();
+		_update_list_positions();
+
+		if( current_game_slot != SIZE_MAX )
+		{
+			m_current_game = &m_games[ current_game_slot ];
+			m_run_time = m_current_game->get_run_time();
+			g_pFZN_WindowMgr->SetWindowTitle( fzn::Tools::Sprintf( "1A1J - %s", m_current_game->get_name().c_str() ) );
+		}
+
+		m_played = parsing_infos.m_total_time;
+
+		_update_run_stats();
+
+		return true;
+	}
+
+	bool SplitsManager::read_lss( const std::filesystem::path& _path )
+	{
+		FZN_LOG( "Reading LiveSplit splits %s...", _path.string().c_str() );
+
+		LssReader reader{};
+
+		if( reader.open( _path ) == false )
+		{
+			FZN_LOG( "Couldn't open file: %s", _path.string().c_str() );
+			return false;
+		}
+
+		close_game_list();
+
+		Utils::ParsingInfos parsing_infos{};
+		parsing_infos.m_resource = &m_list_pool;
+
+		LssReader::Segment segment{};
+		SplitTime previous_personal_best{};
+		size_t last_played_slot{ SIZE_MAX };
+		bool last_played_split{ false };
+
+		while( reader.read_segment( segment ) )
+		{
+			Game::Desc desc{ segment.m_name };
+			desc.m_estimation = segment.get_estimate( previous_personal_best );
+
+			Game& game{ m_games.emplace_back( desc, parsing_infos ) };
+			game.add_sessions( segment.m_sessions, Game::State::playing );
+
+			if( game.has_sessions() )
 			{
-				m_current_game = &m_games.back();
-				m_run_time = m_current_game->get_run_time();
-				g_pFZN_WindowMgr->SetWindowTitle( fzn::Tools::Sprintf( "1A1J - %s", m_current_game->get_name().c_str() ) );
+				last_played_slot = m_games.size() - 1;
+				last_played_split = segment.m_split_in_last_attempt;
 			}
 		}
 
-		m_played = parsing_infos.m_total_time;
+		// A last segment split in the last attempt means the run has been completed, its game is finished instead of current.
+		const bool run_completed{ last_played_slot != SIZE_MAX && last_played_slot == m_games.size() - 1 && last_played_split };
+
+		// The run got as far as the last segment with a history, the ones before it have been finished and the ones after it haven't been played yet.
+		for( size_t slot{ 0 }; slot < m_games.size() && last_played_slot != SIZE_MAX; ++slot )
+		{
+			if( slot == last_played_slot )
+				m_games[ slot ].set_state( run_completed ? Game::State::finished : Game::State::current );
+			else if( slot < last_played_slot && m_games[ slot ].has_sessions() )
+				m_games[ slot ].set_state( Game::State::finished );
+			else
+				m_games[ slot ].set_state( Game::State::none );
+		}
+
+		m_title = reader.get_game_name();
+		m_category = reader.get_category_name();
+
+		_add_games_callbacks();
+		_update_list_positions();
+
+		if( last_played_slot != SIZE_MAX && run_completed == false )
+		{
+			m_current_game = &m_games[ last_played_slot ];
+			m_run_time = m_current_game->get_run_time();
+			g_pFZN_WindowMgr->SetWindowTitle( fzn::Tools::Sprintf( "1A1J - %s", m_current_game->get_name().c_str() ) );
+		}
+
+		FZN_LOG( "%u game(s) read from %u attempt(s).", static_cast< uint32_t >( m_games.size() ), static_cast< uint32_t >( reader.get_nb_attempts() ) );
 
 		_update_run_stats();
 
 		return true;
 	}
 
+	bool SplitsManager::write_lss( const std::filesystem::path& _path ) const
+	{
+		FZN_LOG( "Writing LiveSplit splits %s...", _path.string().c_str() );
+
+		FILE* file{ fopen( _path.string().c_str(), "w" ) };
+
+		if( file == nullptr )
+		{
+			FZN_LOG( "Couldn't open file: %s", _path.string().c_str() );
+			return false;
+		}
+
+		// The printer writes each element in the file as soon as it's pushed.
+		tinyxml2::XMLPrinter printer{ file };
+		Utils::ShortStr text{};
+
+		printer.PushHeader( false, true );
+		printer.OpenElement( "Run" );
+		printer.PushAttribute( "version", "1.7.0" );
+
+		Utils::push_xml_element_with_text( printer, "GameName", m_title.c_str() );
+		Utils::push_xml_element_with_text( printer, "CategoryName", m_category.c_str() );
+		Utils::push_xml_element_with_text( printer, "LayoutPath", m_layout_path.c_str() );
+		Utils::push_xml_element_with_text( printer, "Offset", "00:00:00" );
+
+		snprintf( text.m_buffer.data(), text.m_buffer.size(), "%u", m_nb_sessions );
+		Utils::push_xml_element_with_text( printer, "AttemptCount", text.c_str() );
+
+		// Each session is an attempt of its own so it keeps its date, its id is its split index in the list.
+		printer.OpenElement( "AttemptHistory" );
+		uint32_t split_index{ 1 };
+
+		for( const Game& game : m_games )
+		{
+			for( const Split& split : game.get_splits() )
+			{
+				printer.OpenElement( "Attempt" );
+				printer.PushAttribute( "id", static_cast< int >( split_index++ ) );
+
+				if( split.m_day != Split::no_date )
+				{
+					const SplitDate date{ split.get_date() };
+					snprintf( text.m_buffer.data(), text.m_buffer.size(), "%02u/%02u/%04d 00:00:00", static_cast< unsigned >( date.month() ), static_cast< unsigned >( date.day() ), static_cast< int >( date.year() ) );
+					printer.PushAttribute( "started", text.c_str() );
+				}
+
+				printer.CloseElement();
+			}
+		}
+
+		printer.CloseElement();
+
+		printer.OpenElement( "Segments" );
+		SplitTime run_time{};
+		split_index = 1;
+
+		for( const Game& game : m_games )
+		{
+			printer.OpenElement( "Segment" );
+			Utils::push_xml_element_with_text( printer, "Name", game.get_name().c_str() );
+			printer.OpenElement( "Icon" );
+			printer.CloseElement();
+
+			// Games without sessions don't have a time in the personal best, LiveSplit considers them skipped.
+			run_time += game.get_played();
+			printer.OpenElement( "SplitTimes" );
+			printer.OpenElement( "SplitTime" );
+			printer.PushAttribute( "name", "Personal Best" );
+
+			if( game.has_sessions() )
+				Utils::push_xml_element_with_text( printer, "RealTime", Utils::format_time( run_time, false, true ).c_str() );
+
+			printer.CloseElement();
+			printer.CloseElement();
+
+			printer.OpenElement( "BestSegmentTime" );
+			printer.CloseElement();
+
+			printer.OpenElement( "SegmentHistory" );
+
+			for( const Split& split : game.get_splits() )
+			{
+				printer.OpenElement( "Time" );
+				printer.PushAttribute( "id", static_cast< int >( split_index++ ) );
+				Utils::push_xml_element_with_text( printer, "RealTime", Utils::format_time( split.get_segment_time(), false, true ).c_str() );
+				printer.CloseElement();
+			}
+
+			printer.CloseElement();
+			printer.CloseElement();
+		}
+
+		printer.CloseElement();
+
+		printer.OpenElement( "AutoSplitterSettings" );
+		printer.CloseElement();
+
+		printer.CloseElement();
+		fclose( file );
+
+		FZN_LOG( "%u game(s) and %u session(s) written.", static_cast< uint32_t >( m_games.size() ), split_index - 1 );
+		return true;
+	}
+
 	/**
 	* @brief Write games informations in the given Json root.
 	* @param [in out] _root The Json root that will hold all the games informations
@@ -269,7 +504,8 @@ namespace SplitsMgr
 			run_time = m_run_time + segment_time;
 		}
 
-		if( Utils::is_time_valid( segment_time ) == false )
+		// A session shorter than a second can't be stored, the timer is stopped without adding it.
+		if( Split::is_time_valid( segment_time ) == false )
 			return;
 
 		m_current_game->add_session( segment_time, Utils::today(), _state );
@@ -279,18 +515,401 @@ namespace SplitsMgr
 
 		m_current_game_new_state = Game::State::playing;
 
-		_update_games_data( m_current_game );
+		// _update_run_data moves on to the next game once this one is over, the session is the last one of this game.
+		Game* game{ m_current_game };
+
+		_update_games_data( game );
 		_update_run_data();
-		_update_run_stats();
+		_add_last_session( game );
+		_refresh_run_stats( game->get_list_slot() );
 	}
 
 	void SplitsManager::_on_game_session_added( const Event::GameEvent& _event_infos )
 	{
 		_update_games_data( _event_infos.m_game );
+		_update_run_data();
+		_add_last_session( _event_infos.m_game );
+		_refresh_run_stats( _event_infos.m_game != nullptr ? _event_infos.m_game->get_list_slot() : 0 );
+	}
+
+	void SplitsManager::_add_last_session( const Game* _game )
+	{
+		// The new session is the last one of its game.
+		const bool is_appended{ _game != nullptr && _game->has_sessions() && _game->get_list_slot() < m_sessions.get_nb_games()
+			&& m_sessions.get_game_range( _game->get_list_slot() ).size() + 1 == _game->get_splits().size() };
+
+		if( is_appended == false )
+		{
+			m_sessions.rebuild( m_games );
+			m_rate_model.rebuild( m_sessions, Utils::today() );
+			m_recent_windows.rebuild( m_sessions, Utils::today() );
+			m_streaks.rebuild( m_sessions.get_day_sessions(), m_sessions.get_first_day() );
+		}
+		else
+		{
+			const Split& session{ _game->get_splits().back() };
+			m_sessions.add_session( _game->get_list_slot(), session.m_seconds, session.m_day );
+
+			if( m_rate_model.add_session( session.m_day, session.m_seconds ) == false )
+				m_rate_model.rebuild( m_sessions, Utils::today() );
+
+			m_recent_windows.add_session( session.m_day, session.m_seconds );
+			m_streaks.add_sessions( session.m_day );
+		}
+
+#ifdef _DEBUG
+		_check_incremental_data();
+#endif
+	}
+
+	void SplitsManager::_on_game_session_changed( const Event::GameEvent& _event_infos, bool _deleted )
+	{
+		if( _event_infos.m_game == nullptr || m_games.empty() )
+			return;
+
+		// The games after the changed one get their position from the list index, only the changed game has to be updated in it.
+		const uint32_t game_id{ _event_infos.m_game->get_list_slot() };
+		m_list_index.refresh( game_id, *_event_infos.m_game );
+
+		if( _deleted )
+			m_sessions.remove_session( game_id, _event_infos.m_session_index );
+		else
+			m_sessions.edit_session( game_id, _event_infos.m_session_index, _event_infos.m_new_session.m_seconds, _event_infos.m_new_session.m_day );
+
+		bool rates_updated{ m_rate_model.remove_session( _event_infos.m_old_session.m_day, _event_infos.m_old_session.m_seconds ) };
+
+		if( rates_updated && _deleted == false )
+			rates_updated = m_rate_model.add_session( _event_infos.m_new_session.m_day, _event_infos.m_new_session.m_seconds );
+
+		if( rates_updated == false )
+			m_rate_model.rebuild( m_sessions, Utils::today() );
+
+		if( m_recent_windows.remove_session( _event_infos.m_old_session.m_day, _event_infos.m_old_session.m_seconds ) == false )
+			m_recent_windows.rebuild( m_sessions, Utils::today() );
+		else if( _deleted == false )
+			m_recent_windows.add_session( _event_infos.m_new_session.m_day, _event_infos.m_new_session.m_seconds );
+
+		// Sessions without date aren't counted in the streaks, there's nothing to remove for them.
+		if( m_streaks.remove_session( _event_infos.m_old_session.m_day ) == false && _event_infos.m_old_session.m_day != Split::no_date )
+			m_streaks.rebuild( m_sessions.get_day_sessions(), m_sessions.get_first_day() );
+		else if( _deleted == false )
+			m_streaks.add_sessions( _event_infos.m_new_session.m_day );
+
+#ifdef _DEBUG
+		_check_incremental_data();
+#endif
+
+		_update_run_data();
+		_refresh_run_stats( game_id );
+	}
+
+	void SplitsManager::add_sessions( std::span< const SessionRecord > _sessions )
+	{
+		if( _sessions.empty() || m_games.empty() )
+			return;
+
+		FZN_LOG( "Adding %u session(s)...", static_cast< uint32_t >( _sessions.size() ) );
+
+		// Sessions are grouped by game with a counting sort so each game only receives one insertion and refreshes its time once.
+		m_batch_offsets.assign( m_games.size() + 1, 0 );
+		m_batch_states.assign( m_games.size(), Game::State::none );
+
+		auto is_record_valid = [ this ]( const SessionRecord& _session )
+		{
+			return _session.m_game_index < m_games.size() && Split::is_time_valid( _session.m_time );
+		};
+
+		for( const SessionRecord& session : _sessions )
+		{
+			if( is_record_valid( session ) )
+				++m_batch_offsets[ session.m_game_index + 1 ];
+		}
+
+		for( size_t game_index{ 0 }; game_index < m_games.size(); ++game_index )
+			m_batch_offsets[ game_index + 1 ] += m_batch_offsets[ game_index ];
+
+		m_batch_splits.resize( m_batch_offsets.back() );
+		m_batch_positions.assign( m_batch_offsets.begin(), m_batch_offsets.end() - 1 );
+
+		for( const SessionRecord& session : _sessions )
+		{
+			if( is_record_valid( session ) == false )
+				continue;
+
+			Split& split{ m_batch_splits[ m_batch_positions[ session.m_game_index ]++ ] };
+			split.set_segment_time( session.m_time );
+			split.m_day = session.m_day;
+
+			// Like with successive add_session calls, the game ends up in the state of its last session.
+			m_batch_states[ session.m_game_index ] = session.m_state;
+		}
+
+		Game* new_current_game{ nullptr };
+
+		for( size_t game_index{ 0 }; game_index < m_games.size(); ++game_index )
+		{
+			const uint32_t begin{ m_batch_offsets[ game_index ] };
+			const uint32_t end{ m_batch_offsets[ game_index + 1 ] };
+
+			if( begin == end )
+				continue;
+
+			Game& game{ m_games[ game_index ] };
+			game.add_sessions( std::span< const Split >{ m_batch_splits }.subspan( begin, end - begin ), m_batch_states[ game_index ] );
+			m_list_index.refresh( static_cast< uint32_t >( game_index ), game );
+
+			if( game.is_current() && &game != m_current_game )
+				new_current_game = &game;
+		}
+
+		if( new_current_game != nullptr )
+		{
+			if( m_current_game != nullptr && m_current_game->is_current() )
+				m_current_game->set_state( Game::State::playing );
+
+			m_current_game = new_current_game;
+		}
+		// A finished or abandonned current game is replaced by the next one in _update_run_data, one that is only played again isn't current anymore.
+		else if( m_current_game != nullptr && m_current_game->is_current() == false && m_current_game->are_sessions_over() == false )
+			m_current_game = nullptr;
+
 		_update_run_data();
 		_update_run_stats();
 	}
 
+	void SplitsManager::move_game( uint32_t _from, uint32_t _to )
+	{
+		if( _from == _to || _from >= m_games.size() || _to >= m_games.size() )
+			return;
+
+		FZN_LOG( "Moving %s from position %u to %u.", m_games[ _from ].get_name().c_str(), _from, _to );
+
+		auto get_new_slot = [ _from, _to ]( size_t _slot )
+		{
+			if( _slot == _from )
+				return static_cast< size_t >( _to );
+
+			if( _from < _to && _slot > _from && _slot <= _to )
+				return _slot - 1;
+
+			if( _to < _from && _slot >= _to && _slot < _from )
+				return _slot + 1;
+
+			return _slot;
+		};
+
+		const size_t current_slot{ m_current_game != nullptr ? get_new_slot( m_current_game - m_games.data() ) : SIZE_MAX };
+		const size_t finished_slot{ m_finished_game != nullptr ? get_new_slot( m_finished_game - m_games.data() ) : SIZE_MAX };
+
+		// The games keep their address in the vector, so their callbacks don't have to be registered again.
+		if( _from < _to )
+			std::rotate( m_games.begin() + _from, m_games.begin() + _from + 1, m_games.begin() + _to + 1 );
+		else
+			std::rotate( m_games.begin() + _to, m_games.begin() + _from, m_games.begin() + _from + 1 );
+
+		m_current_game = current_slot != SIZE_MAX ? &m_games[ current_slot ] : nullptr;
+		m_finished_game = finished_slot != SIZE_MAX ? &m_games[ finished_slot ] : nullptr;
+
+		// Only the games between the two positions changed place.
+		for( uint32_t slot{ std::min( _from, _to ) }; slot <= std::max( _from, _to ); ++slot )
+			m_games[ slot ].set_list_slot( &m_list_index, slot );
+
+		m_list_index.move( _from, _to, m_games );
+
+		// Only the sessions table follows the order of the list, the daily data doesn't change. The schedule is computed again from the first moved game.
+		m_sessions.rebuild( m_games );
+		_update_run_data();
+		_refresh_run_stats( std::min( _from, _to ) );
+
+#ifdef _DEBUG
+		_check_incremental_data();
+#endif
+	}
+
+	void SplitsManager::insert_game( uint32_t _slot, const Game::Desc& _desc )
+	{
+		if( _desc.is_valid() == false )
+			return;
+
+		_slot = std::min( _slot, static_cast< uint32_t >( m_games.size() ) );
+		FZN_LOG( "Inserting %s at position %u.", _desc.m_name.c_str(), _slot );
+
+		auto get_new_slot = [ this, _slot ]( const Game* _game )
+		{
+			if( _game == nullptr )
+				return SIZE_MAX;
+
+			const size_t slot{ static_cast< size_t >( _game - m_games.data() ) };
+			return slot >= _slot ? slot + 1 : slot;
+		};
+
+		const size_t current_slot{ get_new_slot( m_current_game ) };
+		const size_t finished_slot{ get_new_slot( m_finished_game ) };
+
+		// The vector can grow with the insertion, the callbacks are registered again with the new addresses of the games.
+		_remove_games_callbacks();
+
+		Utils::ParsingInfos parsing_infos{};
+		parsing_infos.m_resource = &m_list_pool;
+		m_games.emplace( m_games.begin() + _slot, _desc, parsing_infos );
+
+		_add_games_callbacks();
+
+		m_current_game = current_slot != SIZE_MAX ? &m_games[ current_slot ] : nullptr;
+		m_finished_game = finished_slot != SIZE_MAX ? &m_games[ finished_slot ] : nullptr;
+
+		// Every game after the new one moved in the vector anyway, the index is built again.
+		// The sessions of the new game aren't dated, only the sessions table has to be built again, and the schedule from the new game.
+		_update_list_positions();
+		m_sessions.rebuild( m_games );
+		_update_run_data();
+		_refresh_run_stats( _slot );
+
+#ifdef _DEBUG
+		_check_incremental_data();
+#endif
+	}
+
+	bool SplitsManager::import_sessions_csv( const std::filesystem::path& _path )
+	{
+		FZN_LOG( "Importing sessions from csv file %s...", _path.string().c_str() );
+
+		if( m_games.empty() )
+		{
+			FZN_LOG( "No game list loaded, sessions can't be imported." );
+			return false;
+		}
+
+		CsvReader reader{};
+
+		if( reader.open( _path ) == false )
+		{
+			FZN_LOG( "Couldn't open %s.", _path.string().c_str() );
+			return false;
+		}
+
+		std::vector< std::string_view > record{};
+
+		if( reader.read_record( record ) == false )
+		{
+			FZN_LOG( "Empty csv file." );
+			return false;
+		}
+
+		enum Column
+		{
+			game,
+			time,
+			date,
+			state,
+			COUNT
+		};
+
+		auto get_column_from_header = []( std::string_view _header )
+		{
+			struct HeaderAlias
+			{
+				std::string_view	m_name;
+				Column				m_column;
+			};
+
+			// Lower case names, accented letters are compared as they are written in UTF-8.
+			static constexpr HeaderAlias aliases[]{
+				{ "game", game },	{ "name", game },		{ "jeu", game },			{ "nom", game },
+				{ "time", time },	{ "duration", time },	{ "temps", time },			{ "dur\xC3\xA9" "e", time },
+				{ "date", date },	{ "day", date },		{ "jour", date },
+				{ "state", state },	{ "etat", state },		{ "\xC3\xA9tat", state },	{ "\xC3\x89tat", state },
+			};
+
+			while( _header.empty() == false && _header.front() == ' ' )
+				_header.remove_prefix( 1 );
+
+			while( _header.empty() == false && _header.back() == ' ' )
+				_header.remove_suffix( 1 );
+
+			for( const HeaderAlias& alias : aliases )
+			{
+				if( alias.m_name.size() != _header.size() )
+					continue;
+
+				bool same{ true };
+
+				for( size_t character{ 0 }; character < _header.size() && same; ++character )
+					same = alias.m_name[ character ] == static_cast< char >( std::tolower( static_cast< unsigned char >( _header[ character ] ) ) );
+
+				if( same )
+					return alias.m_column;
+			}
+
+			return Column::COUNT;
+		};
+
+		std::array< size_t, Column::COUNT > columns{};
+		columns.fill( SIZE_MAX );
+
+		for( size_t column{ 0 }; column < record.size(); ++column )
+		{
+			const Column header_column{ get_column_from_header( record[ column ] ) };
+
+			if( header_column < Column::COUNT && columns[ header_column ] == SIZE_MAX )
+				columns[ header_column ] = column;
+		}
+
+		if( columns[ Column::game ] == SIZE_MAX || columns[ Column::time ] == SIZE_MAX )
+		{
+			FZN_LOG( "The csv file needs at least a game and a time column." );
+			return false;
+		}
+
+		std::unordered_map< std::string_view, size_t > game_indices{};
+		game_indices.reserve( m_games.size() );
+
+		for( size_t game_index{ 0 }; game_index < m_games.size(); ++game_index )
+			game_indices.emplace( m_games[ game_index ].get_name(), game_index );
+
+		auto get_field = [ &record ]( size_t _column ) -> std::string_view
+		{
+			return _column < record.size() ? record[ _column ] : std::string_view{};
+		};
+
+		std::vector< SessionRecord > sessions{};
+		uint32_t nb_skipped{ 0 };
+
+		while( reader.read_record( record ) )
+		{
+			const auto game_it{ game_indices.find( get_field( columns[ Column::game ] ) ) };
+			const SplitTime session_time{ Utils::parse_time( get_field( columns[ Column::time ] ) ) };
+
+			if( game_it == game_indices.end() || Utils::is_time_valid( session_time ) == false )
+			{
+				FZN_DBLOG( "Line %u: unknown game or invalid time, session skipped.", static_cast< uint32_t >( reader.get_line() ) );
+				++nb_skipped;
+				continue;
+			}
+
+			SessionRecord session{ game_it->second, session_time };
+			const Game& game{ m_games[ game_it->second ] };
+
+			if( columns[ Column::date ] != SIZE_MAX )
+				session.m_day = Utils::check_session_day( Utils::parse_date( get_field( columns[ Column::date ] ) ) );
+
+			if( columns[ Column::state ] != SIZE_MAX )
+				session.m_state = game.get_state_from_str( get_field( columns[ Column::state ] ) );
+
+			// Without a state, the game keeps the one it has, or is considered as being played.
+			if( session.m_state == Game::State::none )
+				session.m_state = game.get_state() != Game::State::none ? game.get_state() : Game::State::playing;
+
+			sessions.push_back( session );
+		}
+
+		if( nb_skipped > 0 )
+			FZN_LOG( "%u line(s) skipped.", nb_skipped );
+
+		add_sessions( sessions );
+		return true;
+	}
+
 	void SplitsManager::_display_timers( const ImVec4& _timer_color )
 	{
 		const float default_text_height = ImGui::CalcTextSize( "T" ).y;
@@ -325,12 +944,12 @@ namespace SplitsMgr
 
 		ImGui_fzn::rect_filled( { debug_rect_pos, rect_size }, ImGui_fzn::color::dark_gray );*/
 
-		std::string time_str = Utils::time_to_str( m_chrono.get_time() );
+		Utils::ShortStr time_str = Utils::format_time( m_chrono.get_time() );
 		ImGui::SetWindowFontScale( 5.f );
 		const ImVec2 session_time_size = ImGui::CalcTextSize( time_str.c_str() );
 		ImGui::SetCursorPos( rect_pos + ImVec2{ rect_size.x * 0.5f - session_time_size.x * 0.5f, 0.f } );
 		const ImVec2 session_time_pos = ImGui::GetCursorPos();
-		ImGui::TextColored( _timer_color, time_str.c_str() );
+		ImGui::TextColored( _timer_color, "%s", time_str.c_str() );
 		ImGui::SetWindowFontScale( 1.f );
 
 		ImGui::SetCursorPos( session_time_pos + ImVec2{ 0.f, session_time_size.y } );
@@ -345,11 +964,11 @@ namespace SplitsMgr
 
 			ImGui::TableNextColumn();
 			ImGui::SetWindowFontScale( 2.f );
-			time_str = Utils::time_to_str( m_current_game->get_played() + m_chrono.get_time() );
+			time_str = Utils::format_time( m_current_game->get_played() + m_chrono.get_time() );
 			ImVec2 size = ImGui::CalcTextSize( time_str.c_str() );
 			ImGui::NewLine();
 			ImGui::SameLine( ImGui::GetContentRegionAvail().x - size.x );
-			ImGui::TextColored( _timer_color, time_str.c_str() );
+			ImGui::TextColored( _timer_color, "%s", time_str.c_str() );
 			ImGui::SetWindowFontScale( 1.f );
 
 			ImGui::TableNextRow();
@@ -359,11 +978,11 @@ namespace SplitsMgr
 
 			ImGui::TableNextColumn();
 			ImGui::SetWindowFontScale( 2.f );
-			time_str = Utils::time_to_str( m_current_game->get_estimate() );
+			time_str = Utils::format_time( m_current_game->get_estimate() );
 			size = ImGui::CalcTextSize( time_str.c_str() );
 			ImGui::NewLine();
 			ImGui::SameLine( ImGui::GetContentRegionAvail().x - size.x );
-			ImGui::TextColored( _timer_color, time_str.c_str() );
+			ImGui::TextColored( _timer_color, "%s", time_str.c_str() );
 			ImGui::SetWindowFontScale( 1.f );
 
 			ImGui::TableNextRow();
@@ -374,11 +993,11 @@ namespace SplitsMgr
 			ImGui::TableNextColumn();
 			ImGui::SetWindowFontScale( 2.f );
 			SplitTime delta = m_current_game->get_played() + m_chrono.get_time() - m_current_game->get_estimate();
-			time_str = fzn::Tools::Sprintf( "%s%s", delta < std::chrono::seconds( 0 ) ? "" : "+", Utils::time_to_str( delta ).c_str() );
+			snprintf( time_str.m_buffer.data(), time_str.m_buffer.size(), "%s%s", delta < std::chrono::seconds( 0 ) ? "" : "+", Utils::format_time( delta ).c_str() );
 			size = ImGui::CalcTextSize( time_str.c_str() );
 			ImGui::NewLine();
 			ImGui::SameLine( ImGui::GetContentRegionAvail().x - size.x );
-			ImGui::TextColored( _timer_color, time_str.c_str() );
+			ImGui::TextColored( _timer_color, "%s", time_str.c_str() );
 			ImGui::SetWindowFontScale( 1.f );
 
 			ImGui::EndTable();
@@ -435,26 +1054,8 @@ namespace SplitsMgr
 		if( _game == nullptr )
 			return;
 
-		SplitTime run_time{};
-
-		// Looping on all the games coming after the given one to update their data.
-		bool game_found{ false };
-		const Game* prev_game{ _game };		// The game that came before the one we're updating. Needed to retrieve game state.
-		const SplitTime& last_segment_time{ _game->get_last_valid_segment_time() };
-		for( Game& game : m_games )
-		{
-			if( game_found == false )
-			{
-				// We found the game, but we don't want to update this one, so we continue one last time.
-				if( &game == _game )
-					game_found = true;
-
-				continue;
-			}
-
-			// Giving the last valid segment of the given game will make the current loop game adapt to it.
-			game.update_data( last_segment_time );
-		}
+		// The games after this one get their position from the list index, only the game itself has to be updated in it.
+		m_list_index.refresh( _game->get_list_slot(), *_game );
 	}
 
 	/**
@@ -495,56 +1096,109 @@ namespace SplitsMgr
 		}
 	}
 
-	void SplitsManager::_update_run_stats()
+#ifdef _DEBUG
+	void SplitsManager::_check_incremental_data() const
 	{
-		m_nb_sessions = 0;
-		m_estimate = SplitTime{};
-		m_played = SplitTime{};
-		m_delta = SplitTime{};
-		m_remaining_time = SplitTime{};
+		SessionTable reloaded_sessions{};
+		reloaded_sessions.rebuild( m_games );
 
-		FZN_LOG( "Updating stats..." );
+		assert( reloaded_sessions == m_sessions && "The sessions table doesn't match the games anymore." );
 
-		for( const Game& game : m_games )
+		RateModel rates{ m_rate_model };
+		rates.advance( Utils::today() );
+
+		RateModel reloaded_rates{};
+		reloaded_rates.rebuild( reloaded_sessions, std::max( Utils::today(), rates.get_last_day() ) );
+
+		assert( ( rates.is_valid() == false || reloaded_rates.is_close_to( rates ) ) && "The rate model doesn't match the sessions anymore." );
+
+		RecentWindows windows{ m_recent_windows };
+		windows.advance( Utils::today() );
+
+		RecentWindows reloaded_windows{};
+		reloaded_windows.rebuild( reloaded_sessions, std::max( Utils::today(), windows.get_last_day() ) );
+
+		assert( reloaded_windows == windows && "The recent windows don't match the sessions anymore." );
+
+		StreakTracker reloaded_streaks{};
+		reloaded_streaks.rebuild( reloaded_sessions.get_day_sessions(), reloaded_sessions.get_first_day() );
+
+		assert( reloaded_streaks == m_streaks && "The streaks don't match the sessions anymore." );
+
+		uint32_t split_index{ 1 };
+		SplitTime run_time{};
+
+		for( uint32_t slot{ 0 }; slot < m_games.size(); ++slot )
 		{
+			const Game& game{ m_games[ slot ] };
+			SplitTime played{};
+			QuantileSketch session_sketch{};
+			StreakTracker streaks{};
+
 			for( const Split& split : game.get_splits() )
 			{
-				if( Utils::is_time_valid( split.m_segment_time ) )
-					++m_nb_sessions;
+				played += split.get_segment_time();
+				session_sketch.add( split.m_seconds );
+				streaks.add_sessions( split.m_day );
 			}
 
-			m_estimate += game.get_estimate();
-			m_played += game.get_played();
+			assert( game.get_list_slot() == slot && game.get_first_split_index() == split_index && game.get_run_time_start() == run_time && "The position of a game in the list is wrong." );
+			assert( game.get_played() == played && "The played time of a game doesn't match its sessions." );
+			assert( game.get_session_sketch() == session_sketch && "The session sketch of a game doesn't match its sessions." );
+			assert( game.get_streaks() == streaks && "The streaks of a game don't match its sessions." );
 
-			if( game.is_finished() )
-				m_delta += game.get_delta();
-
-			if( game.get_state() == Game::State::none )
-				m_remaining_time += game.get_estimate();
-			else if( game.get_state() == Game::State::playing || game.get_state() == Game::State::current )
-			{
-				const SplitTime played{ game.get_played() };
+			split_index += static_cast< uint32_t >( game.get_splits().size() );
+			run_time += played;
+		}
+	}
+#endif
 
-				if( played < game.get_estimate() )
-				{
-					SplitTime game_rem_time = game.get_estimate() - played;
-					m_remaining_time += game_rem_time;
-				}
-			}
+	void SplitsManager::_update_list_positions()
+	{
+		m_list_index.rebuild( m_games );
 
-			FZN_LOG( "%s (%s) - est. %s / played %s / delta %s", game.get_name().c_str(), game.get_state_str(), Utils::time_to_str( game.get_estimate() ).c_str(), Utils::time_to_str( game.get_played() ).c_str(), Utils::time_to_str( game.get_delta() ).c_str() );
-			FZN_LOG( "RUN - est. %s / rem. time %s / played %s / delta %s\n", Utils::time_to_str( m_estimate ).c_str(), Utils::time_to_str( m_remaining_time ).c_str(), Utils::time_to_str( m_played ).c_str(), Utils::time_to_str( m_delta ).c_str() );
-		}
+		for( uint32_t slot{ 0 }; slot < m_games.size(); ++slot )
+			m_games[ slot ].set_list_slot( &m_list_index, slot );
+	}
 
-		m_estimated_final_time = m_remaining_time + m_played;
-		m_stats.refresh( m_games );
+	void SplitsManager::_add_games_callbacks()
+	{
+		for( Game& game : m_games )
+			g_pFZN_Core->AddCallback( &game, &Game::on_event, fzn::DataCallbackType::Event );
+	}
 
-		// Once all the stats have been computed, they can be used for the games that don't have any sessions and can't predict their end date
+	void SplitsManager::_remove_games_callbacks()
+	{
 		for( Game& game : m_games )
-		{
-			if( game.has_sessions() == false )
-				game.compute_end_date();
-		}
+			g_pFZN_Core->RemoveCallback( &game, &Game::on_event, fzn::DataCallbackType::Event );
+	}
+
+	void SplitsManager::_update_run_stats()
+	{
+		FZN_LOG( "Updating stats..." );
+
+		m_sessions.rebuild( m_games );
+		m_rate_model.rebuild( m_sessions, Utils::today() );
+		m_recent_windows.rebuild( m_sessions, Utils::today() );
+		m_streaks.rebuild( m_sessions.get_day_sessions(), m_sessions.get_first_day() );
+		_refresh_run_stats();
+	}
+
+	void SplitsManager::_refresh_run_stats( uint32_t _first_changed_slot )
+	{
+		// The days since the last refresh are counted as days without play until sessions are added on them.
+		m_rate_model.advance( Utils::today() );
+
+		// The run totals are one of the kernels of the stats pipeline, they're computed during the same pass as the other stats.
+		m_stats.refresh( m_games, m_sessions, m_rate_model, _first_changed_slot );
+
+		const RunTotals& run{ m_stats.get_run_totals() };
+		m_nb_sessions = run.m_nb_sessions;
+		m_estimate = run.m_estimate;
+		m_played = run.m_played;
+		m_delta = run.m_delta;
+		m_remaining_time = run.m_remaining_time;
+		m_estimated_final_time = run.m_estimated_final_time;
 
 		FZN_LOG( "Est. final time %s", Utils::time_to_str( m_estimated_final_time ).c_str() );
 	}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <filesystem>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -9,7 +12,12 @@
 
 #include "Game.h"
 #include "Event.h"
+#include "ListIndex.h"
+#include "RateModel.h"
+#include "RecentWindows.h"
+#include "SessionTable.h"
 #include "Stats.h"
+#include "StreakTracker.h"
 
 
 namespace tinyxml2
@@ -22,6 +30,20 @@ namespace SplitsMgr
 	class SplitsManager
 	{
 	public:
+		static constexpr size_t list_arena_initial_size{ 64 * 1024 };
+		static constexpr size_t list_pool_largest_block{ 64 * 1024 };	// Bigger blocks go straight to the arena, no game should have that many sessions.
+
+		/**
+		* @brief A session to add to one of the games of the list with add_sessions.
+		**/
+		struct SessionRecord
+		{
+			size_t				m_game_index{ 0 };		// Index of the game in the list.
+			SplitTime			m_time{};
+			Utils::DayNumber	m_day{ Utils::no_day };
+			Game::State			m_state{ Game::State::playing };	// State of the game once the session has been added.
+		};
+
 		SplitsManager();
 		~SplitsManager();
 
@@ -39,7 +61,12 @@ namespace SplitsMgr
 		SplitTime		get_played() const				{ return m_played; }
 		SplitTime		get_remaining_time() const		{ return m_remaining_time; }
 		const Stats&	get_stats() const				{ return m_stats; }
+		const SessionTable& get_sessions() const		{ return m_sessions; }
+		const RateModel& get_rate_model() const			{ return m_rate_model; }
+		const RecentWindows& get_recent_windows() const	{ return m_recent_windows; }
+		const StreakTracker& get_streaks() const		{ return m_streaks; }
 		bool			are_there_games() const			{ return m_games.size() > 0; }
+		bool			is_timer_running() const		{ return m_chrono.has_started() && m_chrono.is_paused() == false; }
 
 		/**
 		* @brief Open and read the Json file containing all games informations.
@@ -52,17 +79,69 @@ namespace SplitsMgr
 		* @param [in out] _root The Json root that will hold all the games informations
 		**/
 		void write_json( Json::Value& _root );
+		/**
+		* @brief Create a game list from a LiveSplit splits file: each segment is a game and its history are the sessions, dated from the attempts they were played in.
+		* @param _path The path to the .lss file.
+		* @return True if the file has been open and read, false otherwise.
+		**/
+		bool read_lss( const std::filesystem::path& _path );
+		/**
+		* @brief Write the list as a LiveSplit splits file: a segment for each game, with the run time at its end as personal best and its sessions as history.
+		* The file is written while going through the games, the whole xml tree is never built.
+		* @param _path The path to the .lss file.
+		* @return True if the file has been written, false otherwise.
+		**/
+		bool write_lss( const std::filesystem::path& _path ) const;
+
+		/**
+		* @brief Add a batch of sessions, from an import or a journal. The sessions are added to their games in the given order,
+		* then the split indices, the current game and the stats are updated once for the whole batch.
+		* @param _sessions The sessions to add. The ones with an invalid game index or time are skipped.
+		**/
+		void add_sessions( std::span< const SessionRecord > _sessions );
+		/**
+		* @brief Read sessions from a csv file and add them with add_sessions.
+		* The file needs a header line with at least a game name and a time column, the date and state columns are optional.
+		* @param _path The path to the csv file.
+		* @return True if the file has been read, false otherwise.
+		**/
+		bool import_sessions_csv( const std::filesystem::path& _path );
+
+		/**
+		* @brief Move a game to another position of the list, the games in between are shifted by one.
+		* Split indices and run times of the games are read from the list index, so only the positions in between are updated.
+		* @param _from The current position of the game.
+		* @param _to The new position of the game.
+		**/
+		void move_game( uint32_t _from, uint32_t _to );
+		/**
+		* @brief Create a new game from the given description and insert it in the list.
+		* @param _slot The position of the new game, the games from this one are shifted by one.
+		* @param _desc The description of the new game.
+		**/
+		void insert_game( uint32_t _slot, const Game::Desc& _desc );
 
 	private:
 		void _update_sessions( Game::State _state );
 		void _on_game_session_added( const Event::GameEvent& _event_infos );
+		/**
+		* @brief Add the last session of the game to the sessions table, rate model, recent windows and streaks in place.
+		* They're all built again if the session isn't the only new one of the game.
+		**/
+		void _add_last_session( const Game* _game );
+		/**
+		* @brief Update the games after the changed one, the sessions table and the stats after a session has been edited or deleted, without reading all the sessions again.
+		* @param _event_infos The changed game and session.
+		* @param _deleted True if the session has been deleted, false if it has been edited.
+		**/
+		void _on_game_session_changed( const Event::GameEvent& _event_infos, bool _deleted );
 
 		void _display_timers( const ImVec4& _timer_color );
 		void _display_controls();
 
 		/**
-		* @brief Update splits index and run time of games coming after the given one.
-		* @param _game The game that has been updated, and from which the update will start.
+		* @brief Update the position of the games coming after the given one, after a session has been added to it.
+		* @param _game The game that has been updated.
 		**/
 		void _update_games_data( const Game* _game );
 
@@ -72,6 +151,27 @@ namespace SplitsMgr
 		void _update_run_data();
 
 		void _update_run_stats();
+		/**
+		* @brief Refresh the stats and run totals from the sessions table as it is, used when the table has been updated in place.
+		* @param _first_changed_slot Position of the first game that changed, the games before it keep their place in the schedule.
+		**/
+		void _refresh_run_stats( uint32_t _first_changed_slot = 0 );
+		/**
+		* @brief Build the list index again and give every game its position in it, after games have been loaded or inserted.
+		**/
+		void _update_list_positions();
+		/**
+		* @brief Games receive events through callbacks registered with their address, they have to be registered again when the vector moves them.
+		**/
+		void _add_games_callbacks();
+		void _remove_games_callbacks();
+
+#ifdef _DEBUG
+		/**
+		* @brief Check that the data updated in place after an edit is the same as what reading the whole list again gives.
+		**/
+		void _check_incremental_data() const;
+#endif
 
 		void _handle_actions();
 
@@ -91,7 +191,11 @@ namespace SplitsMgr
 		
 		fzn::Chrono m_chrono;
 
+		std::pmr::monotonic_buffer_resource m_list_arena{ list_arena_initial_size };	// Holds the splits of the loaded list, released all at once when the list is closed.
+		// The games allocate from this pool on top of the arena, so the blocks freed when their vectors grow after loading are reused instead of being lost until the list is closed.
+		std::pmr::unsynchronized_pool_resource m_list_pool{ std::pmr::pool_options{ 0, list_pool_largest_block }, &m_list_arena };
 		Games m_games;
+		ListIndex m_list_index;		// Split counts and played time of the games, giving their first split index and starting run time.
 		Game* m_current_game{ nullptr };
 		Game* m_finished_game{ nullptr };
 
@@ -99,6 +203,16 @@ namespace SplitsMgr
 
 		Game::State m_current_game_new_state{ Game::State::playing };
 
+		// Kept between batches of sessions so importing doesn't reallocate them each time.
+		std::vector< uint32_t > m_batch_offsets;
+		std::vector< uint32_t > m_batch_positions;
+		std::vector< Split > m_batch_splits;
+		std::vector< Game::State > m_batch_states;
+
+		SessionTable m_sessions;	// Columnar copy of all the sessions, rebuilt with the run stats.
+		RateModel m_rate_model;		// Play rate per weekday and recent play rate, updated with each session.
+		RecentWindows m_recent_windows;	// Totals of the last 7, 30 and 90 days, updated with each session and each new day.
+		StreakTracker m_streaks;	// Consecutive played days of the whole list, updated with each session.
 		Stats m_stats;
 	};
 } // SplitsMgr
@@ -8,6 +8,8 @@
 #include <FZN/Tools/Logging.h>
 #include <FZN/UI/ImGui.h>
 
+#include "AllocationTracker.h"
+#include "Clock.h"
 #include "SplitsManagerApp.h"
 
 #include <ShlObj.h>
@@ -52,6 +54,8 @@ namespace SplitsMgr
 	**/
 	void SplitsManagerApp::display()
 	{
+		AllocationTracker::begin_frame();
+		Clock::update();
 		const auto window_size = g_pFZN_WindowMgr->GetWindowSize();
 
 		ImGui::SetNextWindowPos( { 0.f, 0.f } );
@@ -105,6 +109,9 @@ namespace SplitsMgr
 
 		ImGui::PopStyleVar( 1 );
 		ImGui::PopStyleColor( 8 );
+
+		AllocationTracker::end_frame();
+		_check_idle_frame_allocations();
 	}
 
 	void SplitsManagerApp::on_event()
@@ -165,10 +172,20 @@ namespace SplitsMgr
 
 				menu_item( "Load...", false, [&]() { _load_json(); } );
 				menu_item( "Save", aio_invalid, [&]() { _save_json(); } );
-				ImGui_fzn::simple_tooltip_on_hover( fzn::Tools::Sprintf( "Loaded file path: %s", m_aio_path.string().c_str() ) );
+
+				if( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+					ImGui_fzn::simple_tooltip_on_hover( fzn::Tools::Sprintf( "Loaded file path: %s", m_aio_path.string().c_str() ) );
 
 				menu_item( "Save As...", no_games, [&]() { _save_json_as(); } );
 
+				ImGui::Separator();
+				menu_item( "Import Sessions...", no_games, [&]() { _import_sessions(); } );
+				ImGui_fzn::simple_tooltip_on_hover( "Add the sessions of a csv file with game, time, date and state columns to the current list." );
+				menu_item( "Import LiveSplit Splits...", false, [&]() { _import_lss(); } );
+				ImGui_fzn::simple_tooltip_on_hover( "Close current file and create a list from the segments and history of a .lss file." );
+				menu_item( "Export LiveSplit Splits...", no_games, [&]() { _export_lss(); } );
+				ImGui_fzn::simple_tooltip_on_hover( "Write the list as a .lss file, with a segment for each game and the sessions as their history." );
+
 				ImGui::Separator();
 				menu_item( "Close Game List", no_games, [&]() { close_game_list(); m_splits_mgr.close_game_list(); } );
 				menu_item( "Reload Json", aio_invalid, [&]() { m_splits_mgr.read_json( m_aio_path.generic_string().c_str() ); } );
@@ -179,12 +196,34 @@ namespace SplitsMgr
 				ImGui::EndMenu();
 			}
 
-			const std::string version{ fzn::Tools::Sprintf( "Ver. %d.%d.%d.%d%s", version_major, version_minor, version_feature, version_bugfix, WIP_version ? " - WIP" : "" ) };
+			static const std::string version{ fzn::Tools::Sprintf( "Ver. %d.%d.%d.%d%s", version_major, version_minor, version_feature, version_bugfix, WIP_version ? " - WIP" : "" ) };
 			const ImVec2 version_size{ ImGui::CalcTextSize( version.c_str() ) };
 			const sf::Vector2u window_size{ g_pFZN_WindowMgr->GetWindowSize() };
 
-			ImGui::SameLine( window_size.x - ImGui::CalcTextSize( version.c_str() ).x - 2.f * ImGui::GetStyle().WindowPadding.x );
-			ImGui::TextColored( ImGui_fzn::color::light_gray, version.c_str() );
+#if SPLITSMGR_ALLOCATION_TRACKING
+			const AllocationTracker::Counters& last_frame{ AllocationTracker::get_last_frame_counters() };
+			Utils::ShortStr allocations{};
+			snprintf( allocations.m_buffer.data(), allocations.m_buffer.size(), "Allocs: %llu (%llu B)", last_frame.m_allocations, last_frame.m_bytes );
+
+			ImGui::SameLine( window_size.x - version_size.x - ImGui::CalcTextSize( allocations.c_str() ).x - 2.f * ImGui::GetStyle().WindowPadding.x - ImGui::GetStyle().ItemSpacing.x );
+			ImGui::TextColored( last_frame.m_allocations > 0 ? ImGui_fzn::color::light_yellow : ImGui_fzn::color::light_gray, "%s", allocations.c_str() );
+
+			if( ImGui::IsItemHovered() && ImGui::BeginTooltip() )
+			{
+				ImGui::TextUnformatted( "Allocations during the last frame:" );
+
+				for( const AllocationTracker::ScopeReport& scope : AllocationTracker::get_last_frame_scopes() )
+				{
+					if( scope.m_name != nullptr )
+						ImGui::Text( "%s: %llu (%llu B)", scope.m_name, scope.m_counters.m_allocations, scope.m_counters.m_bytes );
+				}
+
+				ImGui::EndTooltip();
+			}
+#endif
+
+			ImGui::SameLine( window_size.x - version_size.x - 2.f * ImGui::GetStyle().WindowPadding.x );
+			ImGui::TextColored( ImGui_fzn::color::light_gray, "%s", version.c_str() );
 
 			ImGui::EndMainMenuBar();
 		}
@@ -224,6 +263,90 @@ namespace SplitsMgr
 		writer->write( root, &file );
 	}
 
+	/**
+	* @brief Select a csv file of sessions in explorer and add them to the loaded list.
+	**/
+	void SplitsManagerApp::_import_sessions()
+	{
+		char file[ MAX_PATH ];
+		OPENFILENAME open_file_name;
+		ZeroMemory( &open_file_name, sizeof( open_file_name ) );
+
+		open_file_name.lStructSize = sizeof( open_file_name );
+		open_file_name.hwndOwner = NULL;
+		open_file_name.lpstrFile = file;
+		open_file_name.lpstrFile[ 0 ] = '\0';
+		open_file_name.nMaxFile = sizeof( file );
+		open_file_name.lpstrFileTitle = NULL;
+		open_file_name.nMaxFileTitle = 0;
+		open_file_name.lpstrFilter =	"(*.csv) Sessions\0*.csv\0"
+										"(*.*) All files \0*.*\0";
+		GetOpenFileName( &open_file_name );
+
+		if( open_file_name.lpstrFile[ 0 ] != '\0' )
+			m_splits_mgr.import_sessions_csv( open_file_name.lpstrFile );
+	}
+
+	/**
+	* @brief Select a LiveSplit splits file in explorer and create a new list from it.
+	**/
+	void SplitsManagerApp::_import_lss()
+	{
+		char file[ MAX_PATH ];
+		OPENFILENAME open_file_name;
+		ZeroMemory( &open_file_name, sizeof( open_file_name ) );
+
+		open_file_name.lStructSize = sizeof( open_file_name );
+		open_file_name.hwndOwner = NULL;
+		open_file_name.lpstrFile = file;
+		open_file_name.lpstrFile[ 0 ] = '\0';
+		open_file_name.nMaxFile = sizeof( file );
+		open_file_name.lpstrFileTitle = NULL;
+		open_file_name.nMaxFileTitle = 0;
+		open_file_name.lpstrFilter =	"(*.lss) LiveSplit Splits\0*.lss\0"
+										"(*.*) All files \0*.*\0";
+		GetOpenFileName( &open_file_name );
+
+		if( open_file_name.lpstrFile[ 0 ] == '\0' )
+			return;
+
+		// The list doesn't come from a json file anymore, it will have to be saved as a new one.
+		close_game_list();
+		m_splits_mgr.read_lss( open_file_name.lpstrFile );
+		_save_options();
+	}
+
+	/**
+	* @brief Select where to write the list as a LiveSplit splits file in explorer.
+	**/
+	void SplitsManagerApp::_export_lss()
+	{
+		char file[ MAX_PATH ];
+		OPENFILENAME open_file_name;
+		ZeroMemory( &open_file_name, sizeof( open_file_name ) );
+
+		open_file_name.lStructSize = sizeof( open_file_name );
+		open_file_name.hwndOwner = NULL;
+		open_file_name.lpstrFile = file;
+		open_file_name.lpstrFile[ 0 ] = '\0';
+		open_file_name.nMaxFile = sizeof( file );
+		open_file_name.lpstrFileTitle = NULL;
+		open_file_name.nMaxFileTitle = 0;
+		open_file_name.lpstrFilter =	"(*.lss) LiveSplit Splits\0*.lss\0"
+										"(*.*) All files \0*.*\0";
+		GetSaveFileName( &open_file_name );
+
+		if( open_file_name.lpstrFile[ 0 ] == '\0' )
+			return;
+
+		std::filesystem::path lss_path{ open_file_name.lpstrFile };
+
+		if( lss_path.has_extension() == false )
+			lss_path += ".lss";
+
+		m_splits_mgr.write_lss( lss_path );
+	}
+
 	/**
 	* @brief Select game informations json file in explorer and read it. The path will be saved for later writing in the file.
 	**/
@@ -305,4 +428,25 @@ namespace SplitsMgr
 	{
 		m_creator.show_creation_popup();
 	}
+
+	/**
+	* @brief Check that a frame where the user doesn't interact with the application didn't allocate anything while the timer is running.
+	**/
+	void SplitsManagerApp::_check_idle_frame_allocations()
+	{
+#if SPLITSMGR_ALLOCATION_TRACKING
+		const bool idle_frame{ ImGui::IsAnyItemActive() == false && ImGui::IsAnyItemHovered() == false && ImGui::IsPopupOpen( "", ImGuiPopupFlags_AnyPopupId ) == false };
+
+		if( m_splits_mgr.is_timer_running() == false || idle_frame == false )
+			return;
+
+		const uint64_t idle_allocations{ AllocationTracker::get_last_frame_scope( "Games list" ).m_allocations + AllocationTracker::get_last_frame_scope( "Right panel" ).m_allocations };
+
+		// The frames of the app can't be drawn by the headless benchmark, the regression is caught here on debug builds.
+		if( idle_allocations > 0 )
+			FZN_DBLOG( "Idle frame allocated %llu time(s) with a running timer, per frame display code should not allocate.", idle_allocations );
+
+		assert( idle_allocations == 0 && "An idle frame with a running timer allocated." );
+#endif
+	}
 }
@@ -64,6 +64,24 @@ namespace SplitsMgr
 
 		void _create_json();
 
+		/**
+		* @brief Select a csv file of sessions in explorer and add them to the loaded list.
+		**/
+		void _import_sessions();
+		/**
+		* @brief Select a LiveSplit splits file in explorer and create a new list from it.
+		**/
+		void _import_lss();
+		/**
+		* @brief Select where to write the list as a LiveSplit splits file in explorer.
+		**/
+		void _export_lss();
+
+		/**
+		* @brief Check that a frame where the user doesn't interact with the application didn't allocate anything while the timer is running.
+		**/
+		void _check_idle_frame_allocations();
+
 		std::filesystem::path m_aio_path;
 
 		SplitsManager m_splits_mgr;
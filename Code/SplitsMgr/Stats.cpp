@@ -2,45 +2,76 @@
 #include <FZN/Tools/Logging.h>
 #include <FZN/UI/ImGui.h>
 
+#include "AllocationTracker.h"
 #include "Event.h"
 #include "Stats.h"
 #include "SplitsManagerApp.h"
 
 namespace SplitsMgr
 {
-	void Stats::display()
+	void Stats::display( const Games& _games, const RecentWindows& _windows, const StreakTracker& _streaks )
 	{
+		SPLITSMGR_ALLOCATION_SCOPE( "Stats" );
 		const Options::OptionsDatas& options{ g_splits_app->get_options().get_options_datas() };
+		const GameRecords& games{ m_pipeline.get< GameRecords >() };
+		const DayRecords& days{ m_pipeline.get< DayRecords >() };
+		const SessionQuantiles& quantiles{ m_pipeline.get< SessionQuantiles >() };
+
+		m_forecaster.update();
 
 		ImGui::SeparatorText( "Stats" );
 
 		if( ImGui::BeginChild( "stats" ) )
 		{
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Number of sessions:", "%u", m_nb_sessions );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Number of sessions:", "%u", games.m_nb_sessions );
 			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average sessions per game:", "%.2f", m_avg_sessions );
 			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average sessions per played day:", "%.2f", m_avg_sessions_days );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average session time:", Utils::time_to_str( m_avg_session_time ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Most sessions:", "%s (%u)", m_game_most_sessions.m_string.c_str(), m_game_most_sessions.m_number );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Longest sessions (avg):", "%s (%s)", m_game_longest_sessions.m_string.c_str(), Utils::time_to_str( m_game_longest_sessions.m_time ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Single longest session:", "%s (%s)", m_game_longest_session.m_string.c_str(), Utils::time_to_str( m_game_longest_session.m_time ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Shortest sessions (avg):", "%s (%s)", m_game_shortest_sessions.m_string.c_str(), Utils::time_to_str( m_game_shortest_sessions.m_time ).c_str() );
-			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Single shortest session:", "%s (%s)", m_game_shortest_session.m_string.c_str(), Utils::time_to_str( m_game_shortest_session.m_time ).c_str() );
-
-			if( Utils::is_date_valid( m_begin_date ) )
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average session time:", "%s", Utils::format_time( m_avg_session_time ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Session time percentiles:", "%s / %s / %s", Utils::format_time( quantiles.m_median ).c_str(), Utils::format_time( quantiles.m_p90 ).c_str(), Utils::format_time( quantiles.m_p99 ).c_str() );
+			ImGui::SameLine();
+			ImGui_fzn::helper_simple_tooltip( "Median, 90th and 99th percentile of the session times. Unlike the average, they're barely moved by a few very long or short sessions." );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Most sessions:", "%s (%u)", games.m_most_sessions.m_string.c_str(), games.m_most_sessions.m_number );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Longest sessions (avg):", "%s (%s)", games.m_longest_sessions.m_string.c_str(), Utils::format_time( games.m_longest_sessions.m_time ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Single longest session:", "%s (%s)", games.m_longest_session.m_string.c_str(), Utils::format_time( games.m_longest_session.m_time ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Shortest sessions (avg):", "%s (%s)", games.m_shortest_sessions.m_string.c_str(), Utils::format_time( games.m_shortest_sessions.m_time ).c_str() );
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Single shortest session:", "%s (%s)", games.m_shortest_session.m_string.c_str(), Utils::format_time( games.m_shortest_session.m_time ).c_str() );
+
+			if( Utils::is_day_valid( games.m_begin_day ) )
 			{
 				ImGui::Separator();
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with most sessions:", "%s (%u)", Utils::date_to_str( m_day_most_sessions.m_date, options.m_date_format ).c_str(), m_day_most_sessions.m_number );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with longest played time:", "%s (%s)", Utils::date_to_str( m_day_longest_played.m_date, options.m_date_format ).c_str(), Utils::time_to_str( m_day_longest_played.m_time ).c_str() );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with shortest played time:", "%s (%s)", Utils::date_to_str( m_day_shortest_played.m_date, options.m_date_format ).c_str(), Utils::time_to_str( m_day_shortest_played.m_time ).c_str() );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Game that took the most days:", "%s (%u)", m_game_most_days.m_string.c_str(), m_game_most_days.m_number );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Game that took the fewest days:", "%s (%u)", m_game_fewest_days.m_string.c_str(), m_game_fewest_days.m_number );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with most sessions:", "%s (%u)", Utils::format_date( days.m_most_sessions.m_day, options.m_date_format ).c_str(), days.m_most_sessions.m_number );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with longest played time:", "%s (%s)", Utils::format_date( days.m_longest_played.m_day, options.m_date_format ).c_str(), Utils::format_time( days.m_longest_played.m_time ).c_str() );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Day with shortest played time:", "%s (%s)", Utils::format_date( days.m_shortest_played.m_day, options.m_date_format ).c_str(), Utils::format_time( days.m_shortest_played.m_time ).c_str() );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Game that took the most days:", "%s (%u)", games.m_most_days.m_string.c_str(), games.m_most_days.m_number );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Game that took the fewest days:", "%s (%u)", games.m_fewest_days.m_string.c_str(), games.m_fewest_days.m_number );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Longest streak:", "%u day(s) (until %s)", _streaks.get_longest(), Utils::format_date( _streaks.get_longest_end_day(), options.m_date_format ).c_str() );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Current streak:", "%u day(s)", _streaks.get_current( Utils::today() ) );
+
+				ImGui::Separator();
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "First session:", "%s", Utils::format_date( games.m_begin_day, options.m_date_format ).c_str() );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s (%u day(s))", Utils::format_time( m_avg_session_played_day ).c_str(), days.m_played_days );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s (%u day(s))", Utils::format_time( m_avg_session_day ).c_str(), m_days_since_start );
+
+				ImGui::Separator();
+				_display_windows( _windows );
 
 				ImGui::Separator();
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "First session:", "%s", Utils::date_to_str( m_begin_date, options.m_date_format ).c_str() );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time by day:", "%s (%u day(s))", Utils::time_to_str( m_avg_session_played_day ).c_str(), m_played_days );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Average play time since beginning:", "%s (%u day(s))", Utils::time_to_str( m_avg_session_day ).c_str(), m_days_since_start );
 				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Remaining:", "%u day(s) | %u played day(s) | %u session(s)", m_remaining_days, m_remaining_played_days, m_remaining_sessions );
-				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::date_to_str( m_end_date, options.m_date_format ).c_str() );
+				ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Estimated last day:", "%s", Utils::format_date( m_end_day, options.m_date_format ).c_str() );
+
+				if( m_forecaster.has_results() )
+				{
+					const Forecaster::Percentiles& forecast{ m_forecaster.get_list_forecast() };
+					ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Forecast last day:", "%s / %s / %s", Utils::format_date( forecast.get_day( forecast.m_p10 ), options.m_date_format ).c_str(), Utils::format_date( forecast.get_day( forecast.m_p50 ), options.m_date_format ).c_str(), Utils::format_date( forecast.get_day( forecast.m_p90 ), options.m_date_format ).c_str() );
+					ImGui::SameLine();
+					ImGui_fzn::helper_simple_tooltip( "Last day reached by 10%, 50% and 90% of simulated futures, each day playing as much as a random day since the first session." );
+				}
+
+				_display_rates( _games );
+				_display_schedule( _games, options );
+
+				ImGui::SeparatorText( "Play calendar" );
+				m_heatmap.display( options );
 			}
 
 			ImGui::Spacing();
@@ -48,189 +79,349 @@ namespace SplitsMgr
 		}
 	}
 
-	void Stats::refresh( const Games& _games )
+	void Stats::refresh( const Games& _games, const SessionTable& _sessions, const RateModel& _rates, uint32_t _first_changed_slot )
 	{
 		FZN_DBLOG( "Refreshing stats..." );
 		reset();
 
-		const SplitTime played{ g_splits_app->get_splits_manager().get_played() };
-		const SplitTime remaining_time{ g_splits_app->get_splits_manager().get_remaining_time() };
-		// vector containing all the days where a session happened.
-		std::vector< ComboStat > played_days;
-		std::vector< SplitDate > played_days_game;
-		uint32_t nb_played_games{ 0 };
+		m_pipeline.run( _games, _sessions );
+		_compute_averages( _games, _sessions, _rates );
 
-		for( const Game& game : _games )
-		{
-			if( game.get_state() == Game::State::none )
-				continue;
+		for( uint32_t weekday{ 0 }; weekday < m_weekday_rates.size(); ++weekday )
+			m_weekday_rates[ weekday ] = std::chrono::duration_cast< SplitTime >( std::chrono::duration< double >{ _rates.get_weekday_rate( weekday ) } );
 
-			uint32_t nb_sessions{ 0 };
-			SplitTime game_time{};
-			played_days_game.clear();
-			++nb_played_games;
+		m_recent_rate = std::chrono::duration_cast< SplitTime >( std::chrono::duration< double >{ _rates.get_recent_rate() } );
 
-			const Splits& splits{ game.get_splits() };
+		// Only the games from the changed one move in the schedule, unless the average time per day changed.
+		m_schedule.update( _games, _first_changed_slot, Utils::today(), m_avg_session_day );
+		m_heatmap.update( _sessions, Utils::today() );
+	}
 
-			for( const Split& split : splits )
-			{
-				if( Utils::is_time_valid( split.m_segment_time ) == false )
-					continue;
+	void Stats::_compute_averages( const Games& _games, const SessionTable& _sessions, const RateModel& _rates )
+	{
+		const RunTotals& run{ m_pipeline.get< RunTotals >() };
+		const GameRecords& games{ m_pipeline.get< GameRecords >() };
+		const DayRecords& days{ m_pipeline.get< DayRecords >() };
 
-				++nb_sessions;
-				game_time += split.m_segment_time;
+		if( games.m_nb_played_games == 0 || games.m_nb_sessions == 0 )
+			return;
 
-				if( m_game_longest_session.m_time < split.m_segment_time )
-				{
-					m_game_longest_session.m_string = game.get_name();
-					m_game_longest_session.m_time = split.m_segment_time;
-				}
+		m_avg_sessions = games.m_nb_sessions / static_cast<float>( games.m_nb_played_games );
+		m_avg_session_time = run.m_played / games.m_nb_sessions;
 
-				if( m_game_shortest_session.m_time > split.m_segment_time )
-				{
-					m_game_shortest_session.m_string = game.get_name();
-					m_game_shortest_session.m_time = split.m_segment_time;
-				}
+		if( Utils::is_day_valid( games.m_begin_day ) == false )
+			return;
 
-				if( Utils::is_date_valid( split.m_date ) == false )
-					continue;
+		if( days.m_played_days > 0 )
+		{
+			m_avg_session_played_day = run.m_played / days.m_played_days;
+			m_remaining_played_days = static_cast< uint32_t >( run.m_remaining_time / m_avg_session_played_day );
 
-				auto it_date = std::ranges::find( played_days, split.m_date, &ComboStat::m_date );
-				ComboStat* day_stats{ nullptr };
+			m_avg_sessions_days = games.m_nb_sessions / static_cast< float >( days.m_played_days );
+		}
 
-				// If the split date isn't already in the played dates array, add it.
-				if( it_date == played_days.end() )
-				{
-					played_days.push_back( { .m_date = split.m_date } );
-					day_stats = &played_days.back();
-				}
-				else
-					day_stats = &( *it_date );
+		m_days_since_start = Utils::days_between_dates( games.m_begin_day, Utils::today() );
 
-				++day_stats->m_number;
-				day_stats->m_time += split.m_segment_time;
+		// The first session can be today, or in the future with a clock set earlier.
+		if( m_days_since_start > 0 )
+			m_avg_session_day = run.m_played / m_days_since_start;
+		else
+			m_avg_session_day = run.m_played;
 
-				if( std::ranges::find( played_days_game, split.m_date ) == played_days_game.end() )
-					played_days_game.push_back( split.m_date );
-			}
+		if( Utils::is_time_valid( m_avg_session_day ) )
+			m_remaining_days = static_cast< uint32_t >( run.m_remaining_time / m_avg_session_day );
 
-			if( nb_sessions == 0 )
-				continue;
+		// Weekdays and recent weeks don't play the same amount of time, the rate model predicts the remaining days better than the average.
+		if( _rates.is_valid() )
+			m_remaining_days = _rates.get_remaining_days( Utils::today(), run.m_remaining_time );
 
-			m_nb_sessions += nb_sessions;
-			m_avg_sessions += nb_sessions;
-			m_avg_session_time += game_time;
-			game_time /= nb_sessions;
+		m_remaining_sessions = ceil( m_remaining_played_days * m_avg_sessions_days );
+		m_end_day = Utils::add_days_to_date( Utils::today(), m_remaining_days );
 
-			if( m_game_most_sessions.m_number < nb_sessions )
-			{
-				m_game_most_sessions.m_string = game.get_name();
-				m_game_most_sessions.m_number = nb_sessions;
-			}
+		SplitTime game_remaining{};
 
-			if( m_game_longest_sessions.m_time < game_time )
-			{
-				m_game_longest_sessions.m_string = game.get_name();
-				m_game_longest_sessions.m_time = game_time;
-			}
+		for( const Game& game : _games )
+		{
+			if( game.get_state() == Game::State::current && game.get_played() < game.get_estimate() )
+				game_remaining = game.get_estimate() - game.get_played();
+		}
 
-			if( m_game_shortest_sessions.m_time > game_time )
-			{
-				m_game_shortest_sessions.m_string = game.get_name();
-				m_game_shortest_sessions.m_time = game_time;
-			}
+		if( m_forecast_enabled )
+			m_forecaster.start( _sessions, Utils::today(), game_remaining, run.m_remaining_time );
+	}
 
-			if( m_game_most_days.m_number < played_days_game.size() )
-			{
-				m_game_most_days.m_string = game.get_name();
-				m_game_most_days.m_number = played_days_game.size();
-			}
+	void Stats::_display_rates( const Games& _games )
+	{
+		static constexpr std::array< const char*, 7 > weekday_names{ "Sunday:", "Monday:", "Tuesday:", "Wednesday:", "Thursday:", "Friday:", "Saturday:" };
 
-			if( m_game_fewest_days.m_number > played_days_game.size() )
-			{
-				m_game_fewest_days.m_string = game.get_name();
-				m_game_fewest_days.m_number = played_days_game.size();
-			}
+		if( ImGui::TreeNode( "Play rates" ) == false )
+			return;
 
-			if( Utils::is_date_valid( m_begin_date ) == false || Utils::is_date_valid( game.get_begin_date() ) && m_begin_date > game.get_begin_date() )
-					m_begin_date = game.get_begin_date();
-		}
+		for( uint32_t weekday{ 0 }; weekday < weekday_names.size(); ++weekday )
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, weekday_names[ weekday ], "%s", Utils::format_time( m_weekday_rates[ weekday ] ).c_str() );
 
-		if( nb_played_games == 0 || m_nb_sessions == 0 )
-			return;
+		ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Last weeks:", "%s", Utils::format_time( m_recent_rate ).c_str() );
 
-		m_avg_sessions = m_nb_sessions / static_cast<float>( nb_played_games );
-		m_avg_session_time = played / m_nb_sessions;
+		// Replaying the list takes two refreshes per day, it's only started again when the stats changed.
+		if( m_backtest_version != m_version )
+		{
+			m_backtest.start( _games );
+			m_backtest_version = m_version;
+		}
 
-		if( Utils::is_date_valid( m_begin_date ) == false )
-			return;
+		m_backtest.update();
+		const Backtest::Score& backtest{ m_backtest.get_score() };
 
-		if( played_days.empty() == false )
+		if( m_backtest.is_running() )
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Prediction error:", "computing..." );
+		else if( backtest.m_nb_predictions > 0 )
 		{
-			m_played_days = played_days.size();
-			m_avg_session_played_day = played / m_played_days;
-			m_remaining_played_days = remaining_time / m_avg_session_played_day;
+			ImGui_fzn::bicolor_text( ImGui_fzn::color::light_yellow, ImGui_fzn::color::white, "Prediction error:", "%.1f day(s) (average: %.1f day(s))", backtest.m_mean_errors[ static_cast< size_t >( Backtest::Model::rates ) ], backtest.m_mean_errors[ static_cast< size_t >( Backtest::Model::average ) ] );
+			ImGui::SameLine();
+			ImGui_fzn::helper_simple_tooltip( "Mean error of the predicted remaining days, replaying each day of the history of the list." );
+		}
 
-			m_avg_sessions_days = m_nb_sessions / static_cast< float >( m_played_days );
+		ImGui::TreePop();
+	}
 
-			for( const ComboStat& played_day : played_days )
+	void Stats::_display_windows( const RecentWindows& _windows )
+	{
+		static constexpr std::array< const char*, RecentWindows::nb_windows > window_names{ "Last 7 days", "Last 30 days", "Last 90 days" };
+
+		if( ImGui::BeginTable( "windows_table", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp ) )
+		{
+			auto add_row = []( const char* _name, SplitTime _played, uint32_t _nb_sessions, uint32_t _played_days, SplitTime _average_session )
 			{
-				if( m_day_most_sessions.m_number < played_day.m_number )
-				{
-					m_day_most_sessions.m_date = played_day.m_date;
-					m_day_most_sessions.m_number = played_day.m_number;
-				}
+				ImGui::TableNextColumn();
+				ImGui::TextColored( ImGui_fzn::color::light_yellow, "%s", _name );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%s", Utils::format_time( _played ).c_str() );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%u", _nb_sessions );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%u", _played_days );
+				ImGui::TableNextColumn();
+				ImGui::Text( "%s", Utils::format_time( _average_session ).c_str() );
+			};
+
+			ImGui::TableSetupColumn( "" );
+			ImGui::TableSetupColumn( "Played" );
+			ImGui::TableSetupColumn( "Sessions" );
+			ImGui::TableSetupColumn( "Days" );
+			ImGui::TableSetupColumn( "Avg session" );
+			ImGui::TableHeadersRow();
+
+			for( size_t window{ 0 }; window < window_names.size(); ++window )
+			{
+				const RecentWindows::Totals& totals{ _windows.get_totals( window ) };
+				add_row( window_names[ window ], totals.get_played(), totals.m_nb_sessions, totals.m_played_days, totals.get_average_session() );
+			}
 
-				if( m_day_shortest_played.m_time > played_day.m_time)
-				{
-					m_day_shortest_played.m_date = played_day.m_date;
-					m_day_shortest_played.m_time = played_day.m_time;
-				}
+			add_row( "All time", get_run_totals().m_played, m_pipeline.get< GameRecords >().m_nb_sessions, m_pipeline.get< DayRecords >().m_played_days, m_avg_session_time );
 
-				if( m_day_longest_played.m_time < played_day.m_time )
-				{
-					m_day_longest_played.m_date = played_day.m_date;
-					m_day_longest_played.m_time = played_day.m_time;
-				}
+			ImGui::EndTable();
+		}
+	}
+
+	void Stats::_display_schedule( const Games& _games, const Options::OptionsDatas& _options )
+	{
+		const std::span< const Schedule::Entry > entries{ m_schedule.get_entries() };
+
+		if( entries.size() != _games.size() || ImGui::TreeNode( "Schedule" ) == false )
+			return;
+
+		if( ImGui::BeginTable( "schedule_table", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp ) )
+		{
+			for( size_t slot{ 0 }; slot < entries.size(); ++slot )
+			{
+				// The finished games are written in gray, their days are the ones they have been played on.
+				const ImVec4 color{ entries[ slot ].m_projected ? ImGui_fzn::color::white : ImGui_fzn::color::gray };
+
+				ImGui::TableNextColumn();
+				ImGui::TextColored( color, "%s", _games[ slot ].get_name().c_str() );
+				ImGui::TableNextColumn();
+				ImGui::TextColored( color, "%s", Utils::format_date( entries[ slot ].m_start_day, _options.m_date_format ).c_str() );
+				ImGui::TableNextColumn();
+				ImGui::TextColored( color, "%s", Utils::format_date( entries[ slot ].m_end_day, _options.m_date_format ).c_str() );
 			}
+
+			ImGui::EndTable();
 		}
 
-		m_days_since_start = Utils::days_between_dates( m_begin_date, Utils::today() );
-		m_avg_session_day = played / m_days_since_start;
-		m_remaining_days = remaining_time / m_avg_session_day;
-		m_remaining_sessions = ceil( m_remaining_played_days * m_avg_sessions_days );
-		m_end_date = Utils::add_days_to_date( Utils::today(), m_remaining_days );
+		ImGui::TreePop();
 	}
 
 	void Stats::reset()
 	{
-		m_nb_sessions				= 0;
+		++m_version;
+		m_pipeline.reset();
+
 		m_avg_sessions				= 0.f;
 		m_avg_sessions_days			= 0.f;
 		m_avg_session_time			= SplitTime{};
-		m_played_days				= 0;
 		m_days_since_start			= 0;
 
-		m_begin_date				= SplitDate{};
 		m_avg_session_day			= SplitTime{};
 		m_avg_session_played_day	= SplitTime{};
 
-		m_game_most_sessions		= ComboStat{};
-		m_game_longest_sessions		= ComboStat{};
-		m_game_longest_session		= ComboStat{};
-		m_game_shortest_sessions	= ComboStat{};
-		m_game_shortest_session		= ComboStat{};
+		m_remaining_days			= 0;
+		m_remaining_played_days		= 0;
+		m_remaining_sessions		= 0;
+		m_end_day					= Utils::no_day;
 
-		m_day_most_sessions			= ComboStat{};
-		m_day_shortest_played		= ComboStat{};
-		m_day_longest_played		= ComboStat{};
-		m_game_most_days			= ComboStat{};
-		m_game_fewest_days			= ComboStat{};
+		m_weekday_rates				= {};
+		m_recent_rate				= SplitTime{};
+	}
+
+	void RunTotals::on_game( const StatsEngine::GameSample& _sample )
+	{
+		const Game& game{ *_sample.m_game };
+
+		// Every stored split is a played session.
+		m_nb_sessions += _sample.m_summary.m_count;
+
+		m_estimate += game.get_estimate();
+		m_played += game.get_played();
+
+		if( game.is_finished() )
+			m_delta += game.get_delta();
+
+		if( game.get_state() == Game::State::none )
+			m_remaining_time += game.get_estimate();
+		else if( game.get_state() == Game::State::playing || game.get_state() == Game::State::current )
+		{
+			const SplitTime played{ game.get_played() };
+
+			if( played < game.get_estimate() )
+				m_remaining_time += game.get_estimate() - played;
+		}
+
+		FZN_DBLOG( "%s (%s) - est. %s / played %s / delta %s", game.get_name().c_str(), game.get_state_str(), Utils::time_to_str( game.get_estimate() ).c_str(), Utils::time_to_str( game.get_played() ).c_str(), Utils::time_to_str( game.get_delta() ).c_str() );
+		FZN_DBLOG( "RUN - est. %s / rem. time %s / played %s / delta %s\n", Utils::time_to_str( m_estimate ).c_str(), Utils::time_to_str( m_remaining_time ).c_str(), Utils::time_to_str( m_played ).c_str(), Utils::time_to_str( m_delta ).c_str() );
+	}
+
+	void RunTotals::finish()
+	{
+		m_estimated_final_time = m_remaining_time + m_played;
+	}
+
+	void GameRecords::on_game( const StatsEngine::GameSample& _sample )
+	{
+		const Game& game{ *_sample.m_game };
+
+		if( game.get_state() == Game::State::none )
+			return;
+
+		++m_nb_played_games;
+
+		const uint32_t nb_sessions{ _sample.m_summary.m_count };
+
+		if( nb_sessions == 0 )
+			return;
+
+		const SplitTime longest_time{ _sample.m_summary.get_max() };
+		const SplitTime shortest_time{ _sample.m_summary.get_min() };
+		const SplitTime game_time{ _sample.m_summary.get_average() };
+
+		if( m_longest_session.m_time < longest_time )
+		{
+			m_longest_session.m_string = game.get_name();
+			m_longest_session.m_time = longest_time;
+		}
+
+		if( m_shortest_session.m_time > shortest_time )
+		{
+			m_shortest_session.m_string = game.get_name();
+			m_shortest_session.m_time = shortest_time;
+		}
+
+		m_nb_sessions += nb_sessions;
+
+		if( m_most_sessions.m_number < nb_sessions )
+		{
+			m_most_sessions.m_string = game.get_name();
+			m_most_sessions.m_number = nb_sessions;
+		}
+
+		if( m_longest_sessions.m_time < game_time )
+		{
+			m_longest_sessions.m_string = game.get_name();
+			m_longest_sessions.m_time = game_time;
+		}
+
+		if( m_shortest_sessions.m_time > game_time )
+		{
+			m_shortest_sessions.m_string = game.get_name();
+			m_shortest_sessions.m_time = game_time;
+		}
+
+		if( m_most_days.m_number < _sample.m_nb_days )
+		{
+			m_most_days.m_string = game.get_name();
+			m_most_days.m_number = _sample.m_nb_days;
+		}
+
+		if( m_fewest_days.m_number > _sample.m_nb_days )
+		{
+			m_fewest_days.m_string = game.get_name();
+			m_fewest_days.m_number = _sample.m_nb_days;
+		}
+
+		const Utils::DayNumber begin_day{ game.get_begin_day() };
+
+		if( Utils::is_day_valid( begin_day ) && ( Utils::is_day_valid( m_begin_day ) == false || begin_day < m_begin_day ) )
+			m_begin_day = begin_day;
+	}
+
+	void GameRecords::finish()
+	{
+		// Without any session, the seeds of the shortest records would be displayed.
+		if( m_nb_sessions == 0 )
+		{
+			m_shortest_sessions.m_time = SplitTime{};
+			m_shortest_session.m_time = SplitTime{};
+			m_fewest_days.m_number = 0;
+		}
+	}
 
-		m_game_shortest_session.m_time	= Utils::get_time_from_string( "99:59:59" );
-		m_game_shortest_sessions.m_time = Utils::get_time_from_string( "99:59:59" );
+	void DayRecords::on_day( const StatsEngine::DaySample& _sample )
+	{
+		++m_played_days;
+
+		if( m_most_sessions.m_number < _sample.m_nb_sessions )
+		{
+			m_most_sessions.m_day = _sample.m_day;
+			m_most_sessions.m_number = _sample.m_nb_sessions;
+		}
+
+		if( m_shortest_played.m_time > _sample.get_time() )
+		{
+			m_shortest_played.m_day = _sample.m_day;
+			m_shortest_played.m_time = _sample.get_time();
+		}
+
+		if( m_longest_played.m_time < _sample.get_time() )
+		{
+			m_longest_played.m_day = _sample.m_day;
+			m_longest_played.m_time = _sample.get_time();
+		}
+	}
+
+	void DayRecords::finish()
+	{
+		if( m_played_days == 0 )
+			m_shortest_played.m_time = SplitTime{};
+	}
 
-		m_day_shortest_played.m_time	= Utils::get_time_from_string( "99:59:59" );
-		m_game_fewest_days.m_number		= 9999;
+	void SessionQuantiles::on_game( const StatsEngine::GameSample& _sample )
+	{
+		m_sketch.merge( _sample.m_game->get_session_sketch() );
+	}
+
+	void SessionQuantiles::finish()
+	{
+		m_median = m_sketch.get_quantile( 0.5 );
+		m_p90 = m_sketch.get_quantile( 0.9 );
+		m_p99 = m_sketch.get_quantile( 0.99 );
 	}
 }
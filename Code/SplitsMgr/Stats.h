@@ -1,6 +1,16 @@
 #pragma once
 
+#include "Backtest.h"
+#include "Forecast.h"
 #include "Game.h"
+#include "Heatmap.h"
+#include "QuantileSketch.h"
+#include "RateModel.h"
+#include "RecentWindows.h"
+#include "Schedule.h"
+#include "SessionTable.h"
+#include "StatsEngine.h"
+#include "StreakTracker.h"
 #include "Utils.h"
 
 
@@ -9,53 +19,148 @@ namespace SplitsMgr
 	class ComboStat
 	{
 	public:
-		std::string		m_string{};
-		uint32_t		m_number{ 0 };
-		SplitTime		m_time{};
-		SplitDate		m_date{};
+		std::string			m_string{};
+		uint32_t			m_number{ 0 };
+		SplitTime			m_time{};
+		Utils::DayNumber	m_day{ Utils::no_day };
 	};
 
+	/************************************************************************
+	* @brief Kernels of the stats pipeline, see StatsEngine::Pipeline.
+	************************************************************************/
+	struct RunTotals
+	{
+		void on_game( const StatsEngine::GameSample& _sample );
+		void finish();
+
+		uint32_t	m_nb_sessions{ 0 };
+		SplitTime	m_estimate{};
+		SplitTime	m_played{};
+		SplitTime	m_delta{};
+		SplitTime	m_remaining_time{};
+		SplitTime	m_estimated_final_time{};
+	};
+
+	/**
+	* @brief Records held by a game of the list, only the played games are taken in account.
+	**/
+	struct GameRecords
+	{
+		void on_game( const StatsEngine::GameSample& _sample );
+		void finish();
+
+		uint32_t	m_nb_played_games{ 0 };
+		uint32_t	m_nb_sessions{ 0 };
+		Utils::DayNumber	m_begin_day{ Utils::no_day };		// The earliest date available in the game list.
+
+		ComboStat	m_most_sessions{};
+		ComboStat	m_longest_sessions{};
+		ComboStat	m_longest_session{};
+		ComboStat	m_shortest_sessions{ .m_time = SplitTime::max() };
+		ComboStat	m_shortest_session{ .m_time = SplitTime::max() };
+		ComboStat	m_most_days{};
+		ComboStat	m_fewest_days{ .m_number = UINT32_MAX };
+	};
+
+	/**
+	* @brief Records held by a day, only the days with sessions are taken in account.
+	**/
+	struct DayRecords
+	{
+		void on_day( const StatsEngine::DaySample& _sample );
+		void finish();
+
+		uint32_t	m_played_days{ 0 };
+
+		ComboStat	m_most_sessions{};
+		ComboStat	m_shortest_played{ .m_time = SplitTime::max() };
+		ComboStat	m_longest_played{};
+	};
+
+	/**
+	* @brief Session durations of the whole list, merged from the sketches of the games instead of sorting all the sessions.
+	**/
+	struct SessionQuantiles
+	{
+		void on_game( const StatsEngine::GameSample& _sample );
+		void finish();
+
+		QuantileSketch	m_sketch{};
+		SplitTime		m_median{};
+		SplitTime		m_p90{};
+		SplitTime		m_p99{};
+	};
+
+	using StatsPipeline = StatsEngine::Pipeline< RunTotals, GameRecords, DayRecords, SessionQuantiles >;
+
 	class Stats
 	{
 	public:
-		void display();
+		/**
+		* @param _windows Totals of the last days, shown next to the ones of the whole list.
+		* @param _streaks Consecutive played days of the whole list.
+		**/
+		void display( const Games& _games, const RecentWindows& _windows, const StreakTracker& _streaks );
 
-		void refresh( const Games& _games );
+		/**
+		* @brief Compute all the stats of the list in a single pass over the sessions table, the games are used for their names, states and estimates.
+		* @param _rates Play rates used to predict the remaining days.
+		* @param _first_changed_slot Position of the first game that changed since the last refresh, the schedule is only computed again from there.
+		**/
+		void refresh( const Games& _games, const SessionTable& _sessions, const RateModel& _rates, uint32_t _first_changed_slot = 0 );
+		/**
+		* @brief The forecast runs in the background after each refresh, the backtest replays don't need it.
+		**/
+		void enable_forecast( bool _enabled )			{ m_forecast_enabled = _enabled; }
 
+		const RunTotals& get_run_totals() const			{ return m_pipeline.get< RunTotals >(); }
 		float get_avg_sessions_days() const				{ return m_avg_sessions_days; }
 		SplitTime get_avg_session_played_day() const	{ return m_avg_session_played_day; }
 		SplitTime get_avg_session_day() const			{ return m_avg_session_day; }
-		SplitDate get_begin_date() const				{ return m_begin_date; }
+		Utils::DayNumber get_begin_day() const			{ return m_pipeline.get< GameRecords >().m_begin_day; }
+		const Forecaster& get_forecaster() const		{ return m_forecaster; }
+		const Schedule& get_schedule() const			{ return m_schedule; }
+		uint32_t get_remaining_days() const				{ return m_remaining_days; }
+		Utils::DayNumber get_end_day() const			{ return m_end_day; }
+		uint32_t get_version() const					{ return m_version; }	// Incremented each time the stats change, so the games know when their predictions are outdated.
 
 		void reset();
 
 	private:
+		/**
+		* @brief Averages and remaining days of the list, from the results of the pipeline.
+		**/
+		void _compute_averages( const Games& _games, const SessionTable& _sessions, const RateModel& _rates );
+		void _display_schedule( const Games& _games, const Options::OptionsDatas& _options );
+		/**
+		* @brief The prediction error is only computed when the node is opened, on finished lists and in the background.
+		**/
+		void _display_rates( const Games& _games );
+		void _display_windows( const RecentWindows& _windows );
+
+		StatsPipeline	m_pipeline;
+		Forecaster		m_forecaster;
+		Schedule		m_schedule;
+		Heatmap			m_heatmap;		// Not cleared by reset, a refresh only changes the cells of the days that went to another bucket.
+		uint32_t		m_version{ 0 };
+		bool			m_forecast_enabled{ true };
+
 		// Displayed final variables
-		uint32_t	m_nb_sessions{ 0 };
 		float		m_avg_sessions{ 0.f };
 		float		m_avg_sessions_days{ 0.f };
 		SplitTime	m_avg_session_time{};
 
-		SplitDate	m_begin_date{};					// The earliest date available in the game list.
 		uint32_t	m_remaining_days{};
 		uint32_t	m_remaining_played_days{};
 		uint32_t	m_remaining_sessions{ 0 };
 		SplitTime	m_avg_session_day{};			// Average time on the period between current day and starting day. (taking non played days in account)
 		SplitTime	m_avg_session_played_day{};		// Average time by played day
-		SplitDate	m_end_date{};
-		uint32_t	m_played_days{ 0 };
+		Utils::DayNumber	m_end_day{ Utils::no_day };
 		uint32_t	m_days_since_start{ 0 };
 
-		ComboStat	m_game_most_sessions;
-		ComboStat	m_game_longest_sessions;
-		ComboStat	m_game_longest_session;
-		ComboStat	m_game_shortest_sessions;
-		ComboStat	m_game_shortest_session;
-
-		ComboStat	m_day_most_sessions;
-		ComboStat	m_day_shortest_played;
-		ComboStat	m_day_longest_played;
-		ComboStat	m_game_most_days;
-		ComboStat	m_game_fewest_days;
+		std::array< SplitTime, 7 >	m_weekday_rates{};			// Average play time of each weekday, from sunday.
+		SplitTime					m_recent_rate{};			// Decayed average play time per day of the last weeks.
+		Backtest::Scorer			m_backtest;				// Error of the prediction models on the history of the list.
+		uint32_t					m_backtest_version{ UINT32_MAX };	// Version of the stats m_backtest has been started on.
 	};
 } // namespace SplitsMgr
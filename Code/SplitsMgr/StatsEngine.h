@@ -0,0 +1,148 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "Game.h"
+#include "Reduction.h"
+#include "SessionTable.h"
+
+
+namespace SplitsMgr
+{
+	namespace StatsEngine
+	{
+		/**
+		* @brief What the kernels get for each game of the list, in list order. The durations are summarized once for all of them.
+		**/
+		struct GameSample
+		{
+			uint32_t					m_game_id{ 0 };
+			const Game*					m_game{ nullptr };
+			std::span< const uint32_t >	m_seconds{};
+			std::span< const int32_t >	m_days{};
+			Reduction::Summary			m_summary{};
+			uint32_t					m_nb_days{ 0 };		// Number of different days the game has been played on.
+		};
+
+		/**
+		* @brief What the kernels get for each played day, in chronological order, once all the games have been sent.
+		**/
+		struct DaySample
+		{
+			SplitTime			get_time() const	{ return std::chrono::seconds{ m_seconds }; }
+
+			Utils::DayNumber	m_day{ 0 };
+			uint32_t			m_nb_sessions{ 0 };
+			uint32_t			m_seconds{ 0 };
+		};
+
+		/**
+		* @brief A kernel is a small accumulator, it can implement any of these functions and will only be called for the ones it has:
+		* on_game( const GameSample& ), on_day( const DaySample& ) and finish(). Kernels are reset to their default value before each run.
+		**/
+		template< typename Kernel >
+		concept GameKernel = requires( Kernel& _kernel, const GameSample& _sample ) { _kernel.on_game( _sample ); };
+
+		template< typename Kernel >
+		concept DayKernel = requires( Kernel& _kernel, const DaySample& _sample ) { _kernel.on_day( _sample ); };
+
+		template< typename Kernel >
+		concept FinishingKernel = requires( Kernel& _kernel ) { _kernel.finish(); };
+
+		/************************************************************************
+		* @brief Compute every registered kernel in a single traversal of the sessions table.
+		* Adding a stat is adding a kernel to the list, it doesn't cost another pass over the sessions.
+		************************************************************************/
+		template< typename... Kernels >
+		class Pipeline
+		{
+		public:
+			void run( const Games& _games, const SessionTable& _sessions )
+			{
+				m_kernels = std::tuple< Kernels... >{};
+
+				// Sessions and time of every day between the first and last played ones are kept up to date by the table, indexed by day number minus the first day.
+				const Utils::DayNumber first_day{ _sessions.get_first_day() };
+				const std::span< const uint32_t > day_sessions{ _sessions.get_day_sessions() };
+				const std::span< const uint32_t > day_seconds{ _sessions.get_day_seconds() };
+				m_day_last_game.assign( day_sessions.size(), UINT32_MAX );
+
+				for( uint32_t game_id{ 0 }; game_id < _games.size(); ++game_id )
+				{
+					GameSample sample{ game_id, &_games[ game_id ] };
+
+					if( game_id < _sessions.get_nb_games() )
+					{
+						sample.m_seconds = _sessions.get_game_seconds( game_id );
+						sample.m_days = _sessions.get_game_days( game_id );
+					}
+
+					if( sample.m_seconds.empty() == false )
+						sample.m_summary = Reduction::summarize( sample.m_seconds );
+
+					for( size_t session{ 0 }; session < sample.m_days.size(); ++session )
+					{
+						if( sample.m_days[ session ] == Split::no_date )
+							continue;
+
+						const size_t day_index{ static_cast< size_t >( sample.m_days[ session ] - first_day ) };
+
+						if( m_day_last_game[ day_index ] != game_id )
+						{
+							m_day_last_game[ day_index ] = game_id;
+							++sample.m_nb_days;
+						}
+					}
+
+					_for_each_kernel( [ &sample ]( auto& _kernel )
+					{
+						if constexpr( GameKernel< std::remove_reference_t< decltype( _kernel ) > > )
+							_kernel.on_game( sample );
+					} );
+				}
+
+				for( size_t day_index{ 0 }; day_index < day_sessions.size(); ++day_index )
+				{
+					if( day_sessions[ day_index ] == 0 )
+						continue;
+
+					const DaySample sample{ first_day + static_cast< Utils::DayNumber >( day_index ), day_sessions[ day_index ], day_seconds[ day_index ] };
+
+					_for_each_kernel( [ &sample ]( auto& _kernel )
+					{
+						if constexpr( DayKernel< std::remove_reference_t< decltype( _kernel ) > > )
+							_kernel.on_day( sample );
+					} );
+				}
+
+				_for_each_kernel( []( auto& _kernel )
+				{
+					if constexpr( FinishingKernel< std::remove_reference_t< decltype( _kernel ) > > )
+						_kernel.finish();
+				} );
+			}
+
+			void reset()
+			{
+				m_kernels = std::tuple< Kernels... >{};
+			}
+
+			template< typename Kernel >
+			const Kernel& get() const	{ return std::get< Kernel >( m_kernels ); }
+
+		private:
+			template< typename Function >
+			void _for_each_kernel( Function&& _function )
+			{
+				std::apply( [ &_function ]( Kernels&... _kernels ) { ( _function( _kernels ), ... ); }, m_kernels );
+			}
+
+			std::tuple< Kernels... >	m_kernels{};
+
+			// Kept between runs so refreshing the stats doesn't allocate once the list has been loaded.
+			std::vector< uint32_t >		m_day_last_game;		// Last game that had a session on the day, to count the days of each game.
+		};
+	}
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+
+#include "StreakTracker.h"
+
+
+namespace SplitsMgr
+{
+	StreakTracker::StreakTracker( std::pmr::memory_resource* _resource )
+		: m_day_sessions( _resource )
+		, m_run_lengths( _resource )
+	{
+	}
+
+	void StreakTracker::clear()
+	{
+		m_day_sessions.clear();
+		m_run_lengths.clear();
+		m_first_day = Utils::no_day;
+		m_longest = 0;
+		m_longest_end_day = Utils::no_day;
+	}
+
+	void StreakTracker::rebuild( std::span< const uint32_t > _day_sessions, Utils::DayNumber _first_day )
+	{
+		clear();
+
+		if( Utils::is_day_valid( _first_day ) == false )
+			return;
+
+		for( size_t day_index{ 0 }; day_index < _day_sessions.size(); ++day_index )
+			add_sessions( _first_day + static_cast< Utils::DayNumber >( day_index ), _day_sessions[ day_index ] );
+	}
+
+	void StreakTracker::add_sessions( Utils::DayNumber _day, uint32_t _nb_sessions )
+	{
+		if( Utils::is_day_valid( _day ) == false || _nb_sessions == 0 )
+			return;
+
+		if( m_day_sessions.empty() )
+			m_first_day = _day;
+		else if( _day < m_first_day )
+		{
+			// Only happens for sessions dated before all the others, the days are shifted once for all the ones in between.
+			const size_t nb_new_days{ static_cast< size_t >( m_first_day - _day ) };
+			m_day_sessions.insert( m_day_sessions.begin(), nb_new_days, 0 );
+			m_run_lengths.insert( m_run_lengths.begin(), nb_new_days, 0 );
+			m_first_day = _day;
+		}
+
+		const size_t index{ static_cast< size_t >( _day - m_first_day ) };
+
+		if( index >= m_day_sessions.size() )
+		{
+			m_day_sessions.resize( index + 1, 0 );
+			m_run_lengths.resize( index + 1, 0 );
+		}
+
+		const bool was_played{ m_day_sessions[ index ] > 0 };
+		m_day_sessions[ index ] += _nb_sessions;
+
+		if( was_played )
+			return;
+
+		// The runs ending on the day before and starting on the day after are joined by this one.
+		const uint32_t length_before{ index > 0 && _is_played( index - 1 ) ? m_run_lengths[ index - 1 ] : 0 };
+		const uint32_t length_after{ _is_played( index + 1 ) ? m_run_lengths[ index + 1 ] : 0 };
+		const uint32_t length{ length_before + 1 + length_after };
+
+		m_run_lengths[ index - length_before ] = length;
+		m_run_lengths[ index + length_after ] = length;
+		m_run_lengths[ index ] = length;
+
+		_update_longest( length, _day + static_cast< Utils::DayNumber >( length_after ) );
+	}
+
+	bool StreakTracker::remove_session( Utils::DayNumber _day )
+	{
+		if( Utils::is_day_valid( _day ) == false || Utils::is_day_valid( m_first_day ) == false || _day < m_first_day )
+			return false;
+
+		const size_t index{ static_cast< size_t >( _day - m_first_day ) };
+
+		if( _is_played( index ) == false )
+			return false;
+
+		if( --m_day_sessions[ index ] == 0 )
+			_rebuild_runs();
+
+		return true;
+	}
+
+	uint32_t StreakTracker::get_current( Utils::DayNumber _today ) const
+	{
+		if( Utils::is_day_valid( _today ) == false || Utils::is_day_valid( m_first_day ) == false || _today < m_first_day )
+			return 0;
+
+		size_t index{ static_cast< size_t >( _today - m_first_day ) };
+
+		if( _is_played( index ) == false )
+		{
+			if( index == 0 || _is_played( index - 1 ) == false )
+				return 0;
+
+			--index;
+		}
+
+		if( _is_played( index + 1 ) == false )
+			return m_run_lengths[ index ];
+
+		// Sessions dated after the given day, it's in the middle of its run which only knows its length on its ends.
+		uint32_t length{ 1 };
+
+		while( index >= length && _is_played( index - length ) )
+			++length;
+
+		return length;
+	}
+
+	bool StreakTracker::operator==( const StreakTracker& _other ) const
+	{
+		return m_first_day == _other.m_first_day && std::ranges::equal( m_day_sessions, _other.m_day_sessions ) && m_longest == _other.m_longest && m_longest_end_day == _other.m_longest_end_day;
+	}
+
+	void StreakTracker::_update_longest( uint32_t _length, Utils::DayNumber _end_day )
+	{
+		if( _length > m_longest || ( _length == m_longest && _end_day < m_longest_end_day ) )
+		{
+			m_longest = _length;
+			m_longest_end_day = _end_day;
+		}
+	}
+
+	void StreakTracker::_rebuild_runs()
+	{
+		// Days without sessions at the ends are dropped, so the days stored only depend on the sessions.
+		const auto first_played{ std::ranges::find_if( m_day_sessions, []( uint32_t _nb_sessions ) { return _nb_sessions > 0; } ) };
+		const size_t nb_dropped_days{ static_cast< size_t >( first_played - m_day_sessions.begin() ) };
+
+		m_day_sessions.erase( m_day_sessions.begin(), first_played );
+		m_run_lengths.erase( m_run_lengths.begin(), m_run_lengths.begin() + nb_dropped_days );
+		m_first_day = m_day_sessions.empty() ? Utils::no_day : m_first_day + static_cast< Utils::DayNumber >( nb_dropped_days );
+
+		while( m_day_sessions.empty() == false && m_day_sessions.back() == 0 )
+		{
+			m_day_sessions.pop_back();
+			m_run_lengths.pop_back();
+		}
+
+		m_longest = 0;
+		m_longest_end_day = Utils::no_day;
+
+		size_t run_start{ 0 };
+
+		for( size_t index{ 0 }; index < m_day_sessions.size(); ++index )
+		{
+			if( m_day_sessions[ index ] == 0 )
+			{
+				m_run_lengths[ index ] = 0;
+				run_start = index + 1;
+				continue;
+			}
+
+			if( _is_played( index + 1 ) )
+				continue;
+
+			const uint32_t length{ static_cast< uint32_t >( index + 1 - run_start ) };
+			std::fill( m_run_lengths.begin() + run_start, m_run_lengths.begin() + index + 1, length );
+
+			_update_longest( length, m_first_day + static_cast< Utils::DayNumber >( index ) );
+		}
+	}
+}
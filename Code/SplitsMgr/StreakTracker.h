@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "Utils.h"
+
+
+namespace SplitsMgr
+{
+	/************************************************************************
+	* @brief Runs of consecutive played days, from the number of sessions of each day.
+	* The length of a run is stored on its first and last days, so a newly played day joins the runs on both sides of it without going through them.
+	************************************************************************/
+	class StreakTracker
+	{
+	public:
+		explicit StreakTracker( std::pmr::memory_resource* _resource = std::pmr::get_default_resource() );
+
+		void clear();
+		/**
+		* @brief Read the number of sessions of consecutive days, like the daily totals of the sessions table.
+		**/
+		void rebuild( std::span< const uint32_t > _day_sessions, Utils::DayNumber _first_day );
+		/**
+		* @brief Count sessions on the given day, sessions without date aren't part of any streak.
+		**/
+		void add_sessions( Utils::DayNumber _day, uint32_t _nb_sessions = 1 );
+		/**
+		* @brief Remove a session from its day. If it was the only one of the day, its run is split and the runs are computed again.
+		* @return False if the day has no session.
+		**/
+		bool remove_session( Utils::DayNumber _day );
+
+		uint32_t			get_longest() const				{ return m_longest; }
+		Utils::DayNumber	get_longest_end_day() const		{ return m_longest_end_day; }
+		/**
+		* @brief Number of consecutive played days until the given day. The streak isn't broken until the day is over, so it can end on the day before.
+		**/
+		uint32_t			get_current( Utils::DayNumber _today ) const;
+
+		/**
+		* @brief Two trackers are the same if they have the same sessions on the same days, the runs being computed from them.
+		**/
+		bool operator==( const StreakTracker& _other ) const;
+
+	private:
+		bool _is_played( size_t _index ) const			{ return _index < m_day_sessions.size() && m_day_sessions[ _index ] > 0; }
+		void _update_longest( uint32_t _length, Utils::DayNumber _end_day );
+		/**
+		* @brief Compute all the runs and the longest one again, after a day hasn't any session anymore.
+		**/
+		void _rebuild_runs();
+
+		std::pmr::vector< uint32_t >	m_day_sessions;			// Number of sessions of each day, indexed by day number minus the first day.
+		std::pmr::vector< uint32_t >	m_run_lengths;			// Length of the run of each day, only up to date on the first and last days of a run.
+		Utils::DayNumber				m_first_day{ Utils::no_day };
+
+		uint32_t						m_longest{ 0 };
+		Utils::DayNumber				m_longest_end_day{ Utils::no_day };		// Last day of the earliest of the longest runs.
+	};
+}
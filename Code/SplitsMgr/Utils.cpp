@@ -1,4 +1,5 @@
-#include <format>
+#include <charconv>
+#include <cstdio>
 #include <fstream>
 
 #include <tinyXML2/tinyxml2.h>
@@ -7,6 +8,7 @@
 
 #include "../External/base64.hpp"
 
+#include "Clock.h"
 #include "Utils.h"
 
 
@@ -39,6 +41,13 @@ namespace SplitsMgr
 			_container->InsertEndChild( new_elem );
 		}
 
+		void push_xml_element_with_text( tinyxml2::XMLPrinter& _printer, const char* _name, const char* _text )
+		{
+			_printer.OpenElement( _name );
+			_printer.PushText( _text );
+			_printer.CloseElement();
+		}
+
 		SplitTime get_time_from_string( std::string_view _time, std::string_view _format /*= "%H:%M:%S" */ )
 		{
 			std::stringstream stream;
@@ -58,12 +67,86 @@ namespace SplitsMgr
 			else
 				stream << _time;
 
-			std::chrono::duration<int, std::milli> ret_time{};
+			SplitTime ret_time{};
 			std::chrono::from_stream( stream, _format.data(), ret_time );
 
 			return ret_time;
 		}
 
+		SplitTime parse_time( std::string_view _time )
+		{
+			while( _time.empty() == false && ( _time.front() == ' ' || _time.front() == '\t' ) )
+				_time.remove_prefix( 1 );
+
+			while( _time.empty() == false && ( _time.back() == ' ' || _time.back() == '\t' || _time.back() == '\r' ) )
+				_time.remove_suffix( 1 );
+
+			auto read_number = [ &_time ]( int64_t& _value )
+			{
+				const auto [ end, error ] = std::from_chars( _time.data(), _time.data() + _time.size(), _value );
+
+				if( error != std::errc{} )
+					return false;
+
+				_time.remove_prefix( end - _time.data() );
+				return true;
+			};
+
+			auto skip_separator = [ &_time ]( char _separator )
+			{
+				if( _time.empty() || _time.front() != _separator )
+					return false;
+
+				_time.remove_prefix( 1 );
+				return true;
+			};
+
+			const size_t first_colon{ _time.find( ':' ) };
+
+			if( first_colon == std::string_view::npos )
+				return SplitTime{};
+
+			int64_t days{ 0 };
+			int64_t hours{ 0 };
+			int64_t minutes{ 0 };
+			int64_t seconds{ 0 };
+			int64_t milliseconds{ 0 };
+
+			// A dot before the hours means the time is greater than a day, like in the .lss files.
+			if( const size_t dot{ _time.find( '.' ) }; dot != std::string_view::npos && dot < first_colon )
+			{
+				if( read_number( days ) == false || skip_separator( '.' ) == false )
+					return SplitTime{};
+			}
+
+			if( read_number( hours ) == false || skip_separator( ':' ) == false || read_number( minutes ) == false )
+				return SplitTime{};
+
+			if( skip_separator( ':' ) )
+			{
+				if( read_number( seconds ) == false )
+					return SplitTime{};
+
+				if( skip_separator( '.' ) )
+				{
+					// Only the milliseconds are kept from the fraction.
+					int64_t scale{ 100 };
+
+					while( _time.empty() == false && _time.front() >= '0' && _time.front() <= '9' )
+					{
+						milliseconds += ( _time.front() - '0' ) * scale;
+						scale /= 10;
+						_time.remove_prefix( 1 );
+					}
+				}
+			}
+
+			if( _time.empty() == false )
+				return SplitTime{};
+
+			return std::chrono::hours{ days * 24 + hours } + std::chrono::minutes{ minutes } + std::chrono::seconds{ seconds } + std::chrono::milliseconds{ milliseconds };
+		}
+
 		SplitDate get_date_from_string( std::string_view _date, std::string_view _format /*= "%F" */ )
 		{
 			std::stringstream stream{};
@@ -74,45 +157,121 @@ namespace SplitsMgr
 
 			return ret_date;
 		}
-		
-		std::string time_to_str( const SplitTime& _time, bool _floor_seconds /*= true */, bool _separate_days /*= false*/ )
+
+		DayNumber parse_date( std::string_view _date )
 		{
-			std::string time_string{};
+			while( _date.empty() == false && ( _date.front() == ' ' || _date.front() == '\t' ) )
+				_date.remove_prefix( 1 );
+
+			while( _date.empty() == false && ( _date.back() == ' ' || _date.back() == '\t' || _date.back() == '\r' ) )
+				_date.remove_suffix( 1 );
 
-			auto durations_hours = duration_cast<std::chrono::hours>(_time );
-			int days = durations_hours.count() / 24;
-			int hours = durations_hours.count() - days * 24;
+			int values[ 3 ]{};
+			const char* current{ _date.data() };
+			const char* const end{ _date.data() + _date.size() };
 
-			if( _separate_days && days > 0 )
+			for( int value_index{ 0 }; value_index < 3; ++value_index )
 			{
-				time_string = fzn::Tools::Sprintf( "%d.%02d:", days, hours );
-				time_string += std::format( "{:%M:}", _time );
+				if( value_index > 0 )
+				{
+					if( current == end || *current != '-' )
+						return no_day;
+
+					++current;
+				}
+
+				const auto [ number_end, error ] = std::from_chars( current, end, values[ value_index ] );
+
+				if( error != std::errc{} )
+					return no_day;
+
+				current = number_end;
 			}
-			else
-				time_string = std::format( "{:%H:%M:}", _time );
 
-			if( _floor_seconds )
-				time_string += std::format( "{:%S}", abs( std::chrono::floor< std::chrono::seconds >( _time ) ) );
+			// Checked before building the date, month and day are stored on a byte and would wrap.
+			if( current != end || values[ 1 ] < 1 || values[ 1 ] > 12 || values[ 2 ] < 1 || values[ 2 ] > 31 )
+				return no_day;
+
+			const SplitDate date{ std::chrono::year{ values[ 0 ] }, std::chrono::month{ static_cast< unsigned >( values[ 1 ] ) }, std::chrono::day{ static_cast< unsigned >( values[ 2 ] ) } };
+
+			if( date.ok() == false )
+				return no_day;
+
+			return to_day_number( date );
+		}
+		
+		std::string time_to_str( const SplitTime& _time, bool _floor_seconds /*= true */, bool _separate_days /*= false*/ )
+		{
+			return format_time( _time, _floor_seconds, _separate_days ).c_str();
+		}
+
+		std::string date_to_str( const SplitDate& _date, Options::DateFormat _format /*= Options::DateFormat::ISO8601*/ )
+		{
+			return format_date( _date, _format ).c_str();
+		}
+
+		ShortStr format_time( const SplitTime& _time, bool _floor_seconds /*= true */, bool _separate_days /*= false*/ )
+		{
+			ShortStr time_string{};
+
+			const auto abs_time = abs( _time );
+			const auto total_hours = std::chrono::duration_cast< std::chrono::hours >( abs_time ).count();
+			const auto minutes = std::chrono::duration_cast< std::chrono::minutes >( abs_time ).count() % 60;
+			const auto seconds = std::chrono::duration_cast< std::chrono::seconds >( abs_time ).count() % 60;
+			const auto milliseconds = abs_time.count() % 1000;
+			const char* sign{ _time < SplitTime{} ? "-" : "" };
+
+			int length{ 0 };
+			char* buffer{ time_string.m_buffer.data() };
+			const size_t buffer_size{ time_string.m_buffer.size() };
+
+			if( _separate_days && total_hours >= 24 )
+				length = snprintf( buffer, buffer_size, "%s%lld.%02lld:%02lld:%02lld", sign, static_cast< long long >( total_hours / 24 ), static_cast< long long >( total_hours % 24 ), static_cast< long long >( minutes ), static_cast< long long >( seconds ) );
 			else
-				time_string += std::format( "{:%S}", abs( _time ) );
+				length = snprintf( buffer, buffer_size, "%s%02lld:%02lld:%02lld", sign, static_cast< long long >( total_hours ), static_cast< long long >( minutes ), static_cast< long long >( seconds ) );
+
+			if( _floor_seconds == false && length > 0 && static_cast< size_t >( length ) < buffer_size )
+				snprintf( buffer + length, buffer_size - length, ".%03lld", static_cast< long long >( milliseconds ) );
 
 			return time_string;
 		}
 
-		std::string date_to_str( const SplitDate& _date, Options::DateFormat _format /*= Options::DateFormat::ISO8601*/ )
+		ShortStr format_date( const SplitDate& _date, Options::DateFormat _format /*= Options::DateFormat::ISO8601*/ )
 		{
+			static constexpr std::array< const char*, 12 > month_names{ "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+			ShortStr date_string{};
+
 			if( Utils::is_date_valid( _date ) == false )
-				return "<No Date>";
+			{
+				snprintf( date_string.m_buffer.data(), date_string.m_buffer.size(), "<No Date>" );
+				return date_string;
+			}
+
+			const int year{ static_cast< int >( _date.year() ) };
+			const unsigned month{ static_cast< unsigned >( _date.month() ) };
+			const unsigned day{ static_cast< unsigned >( _date.day() ) };
 
 			switch( _format )
 			{
 				case Options::DMYName:
-					return std::format( "{:%d %b %Y}", _date );
-
+				{
+					snprintf( date_string.m_buffer.data(), date_string.m_buffer.size(), "%02u %s %d", day, month_names[ ( month - 1 ) % 12 ], year );
+					break;
+				}
 				case Options::DateFormat::ISO8601:
 				default:
-					return std::format( "{:%F}", _date );
+				{
+					snprintf( date_string.m_buffer.data(), date_string.m_buffer.size(), "%04d-%02u-%02u", year, month, day );
+					break;
+				}
 			};
+
+			return date_string;
+		}
+
+		ShortStr format_date( DayNumber _day, Options::DateFormat _format /*= Options::DateFormat::ISO8601*/ )
+		{
+			return format_date( to_date( _day ), _format );
 		}
 
 		bool is_time_valid( const SplitTime& _time )
@@ -125,11 +284,19 @@ namespace SplitsMgr
 			return _date != SplitDate{};
 		}
 
-		SplitDate today()
+		DayNumber today()
 		{
-			const std::chrono::time_point now{ std::chrono::system_clock::now() };
-			
-			return std::chrono::floor< std::chrono::days >( now );
+			return Clock::get_day();
+		}
+
+		DayNumber check_session_day( DayNumber _day )
+		{
+			// Tomorrow is still accepted, the clock of the computer may be behind the time zone the session has been dated in.
+			if( is_day_valid( _day ) == false || ( _day >= 0 && _day <= today() + 1 ) )
+				return _day;
+
+			FZN_LOG( "Session date %s is out of range, the session is kept without date.", format_date( _day ).c_str() );
+			return no_day;
 		}
 
 		std::string get_cover_data( std::string_view _cover_path )
@@ -175,20 +342,5 @@ namespace SplitsMgr
 				ImGui::EndTable();
 			}
 		}
-
-		uint32_t days_between_dates( const SplitDate& _day_1, const SplitDate& _day_2 )
-		{
-			std::chrono::system_clock::time_point tp_day_1 = std::chrono::time_point<std::chrono::system_clock, std::chrono::days>( std::chrono::sys_days{ _day_1 } );
-			std::chrono::system_clock::time_point tp_day_2 = std::chrono::time_point<std::chrono::system_clock, std::chrono::days>( std::chrono::sys_days{ _day_2 } );
-
-			return std::chrono::duration_cast<std::chrono::days>( tp_day_2 - tp_day_1 ).count();
-		}
-
-		SplitDate add_days_to_date( const SplitDate& _start_day, uint32_t _nb_days )
-		{
-			std::chrono::system_clock::time_point tp_day_2 = std::chrono::time_point<std::chrono::system_clock, std::chrono::days>( std::chrono::sys_days{ _start_day } );
-			
-			return std::chrono::floor< std::chrono::days >( tp_day_2 + std::chrono::days{ _nb_days } );
-		}
 	}
 }
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string_view>
 #include <chrono>
 #include <functional>
+#include <memory_resource>
 
 #include "Externals/ImGui/imgui.h"
 
@@ -13,11 +16,12 @@ namespace tinyxml2
 {
 	class XMLElement;
 	class XMLDocument;
+	class XMLPrinter;
 }
 
 namespace SplitsMgr
 {
-	using SplitTime = std::chrono::duration<int, std::milli>;
+	using SplitTime = std::chrono::duration<int64_t, std::milli>;		// 64 bits so the time of a whole list can't overflow, an int would stop at 596 hours.
 	using SplitDate = std::chrono::year_month_day;
 	static constexpr ImVec2 DefaultWidgetSize{ 150.f, 0.f };
 
@@ -53,24 +57,103 @@ namespace SplitsMgr
 			static constexpr ImVec4		no_state_header_active			{ 0.26f, 0.59f , 0.98f, 1.f };
 		}
 
+		/**
+		* @brief Dates are handled as a number of days since 1970-01-01 so comparing them or counting the days between them are integer operations.
+		* They're only converted to year_month_day when they're read, displayed or written.
+		**/
+		using DayNumber = int32_t;
+		static constexpr DayNumber no_day{ INT32_MIN };
+
+		/**
+		* @brief Conversions between civil dates and day numbers, from the days_from_civil and civil_from_days algorithms of Howard Hinnant.
+		**/
+		constexpr DayNumber to_day_number( const SplitDate& _date )
+		{
+			if( _date == SplitDate{} )
+				return no_day;
+
+			const unsigned month{ static_cast< unsigned >( _date.month() ) };
+			const unsigned day{ static_cast< unsigned >( _date.day() ) };
+			const int year{ static_cast< int >( _date.year() ) - ( month <= 2 ? 1 : 0 ) };
+			const int era{ ( year >= 0 ? year : year - 399 ) / 400 };
+			const unsigned year_of_era{ static_cast< unsigned >( year - era * 400 ) };
+			const unsigned day_of_year{ ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5 + day - 1 };
+			const unsigned day_of_era{ year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year };
+
+			return era * 146097 + static_cast< int >( day_of_era ) - 719468;
+		}
+
+		constexpr SplitDate to_date( DayNumber _day )
+		{
+			if( _day == no_day )
+				return SplitDate{};
+
+			const int shifted_day{ _day + 719468 };
+			const int era{ ( shifted_day >= 0 ? shifted_day : shifted_day - 146096 ) / 146097 };
+			const unsigned day_of_era{ static_cast< unsigned >( shifted_day - era * 146097 ) };
+			const unsigned year_of_era{ ( day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096 ) / 365 };
+			const unsigned day_of_year{ day_of_era - ( 365 * year_of_era + year_of_era / 4 - year_of_era / 100 ) };
+			const unsigned shifted_month{ ( 5 * day_of_year + 2 ) / 153 };
+			const unsigned day{ day_of_year - ( 153 * shifted_month + 2 ) / 5 + 1 };
+			const unsigned month{ shifted_month < 10 ? shifted_month + 3 : shifted_month - 9 };
+			const int year{ static_cast< int >( year_of_era ) + era * 400 + ( month <= 2 ? 1 : 0 ) };
+
+			return SplitDate{ std::chrono::year{ year }, std::chrono::month{ month }, std::chrono::day{ day } };
+		}
+
+		constexpr bool is_day_valid( DayNumber _day )								{ return _day != no_day; }
+		constexpr uint32_t days_between_dates( DayNumber _day_1, DayNumber _day_2 )		{ return _day_2 > _day_1 ? static_cast< uint32_t >( _day_2 - _day_1 ) : 0; }	// 0 if the second day is before the first one.
+		constexpr DayNumber add_days_to_date( DayNumber _start_day, uint32_t _nb_days )	{ return _start_day + static_cast< DayNumber >( _nb_days ); }
+
 		struct ParsingInfos
 		{
 			uint32_t m_split_index{ 1 };
 			SplitTime m_total_time{};
+			std::pmr::memory_resource* m_resource{ std::pmr::get_default_resource() };	// Where the parsed games allocate their splits.
+		};
+
+		/**
+		* @brief Small fixed size string, used to format times and dates displayed every frame without allocating.
+		**/
+		struct ShortStr
+		{
+			const char* c_str() const	{ return m_buffer.data(); }
+
+			std::array< char, 32 > m_buffer{};
 		};
 
 		std::string get_xml_child_element_text( tinyxml2::XMLElement* _container, std::string_view _child_name );
 		void create_xml_child_element_with_text( tinyxml2::XMLDocument& _document, tinyxml2::XMLElement* _container, std::string_view _child_name, std::string_view _text );
+		/**
+		* @brief Write an element holding the given text with a printer, for the files streamed without building a document.
+		**/
+		void push_xml_element_with_text( tinyxml2::XMLPrinter& _printer, const char* _name, const char* _text );
 
 		SplitTime get_time_from_string( std::string_view _time, std::string_view _format = "%4H:%M:%S" );
+		/**
+		* @brief Parse a time written as "[days.]hours:minutes[:seconds[.fraction]]" without going through a stream, like the times of the lists and pasted sheets.
+		* @return The parsed time, or an empty one if the string doesn't follow the format.
+		**/
+		SplitTime parse_time( std::string_view _time );
 		SplitDate get_date_from_string( std::string_view _date, std::string_view _format = "%F" );
+		/**
+		* @brief Parse a date written as "year-month-day" without going through a stream, for the imports reading a lot of them.
+		* @return The day number of the date, or no_day if the string isn't a valid date.
+		**/
+		DayNumber parse_date( std::string_view _date );
 		std::string time_to_str( const SplitTime& _time, bool _floor_seconds = true, bool _separate_days = false );
 		std::string date_to_str( const SplitDate& _date, Options::DateFormat _format = Options::DateFormat::ISO8601 );
+		ShortStr format_time( const SplitTime& _time, bool _floor_seconds = true, bool _separate_days = false );
+		ShortStr format_date( const SplitDate& _date, Options::DateFormat _format = Options::DateFormat::ISO8601 );
+		ShortStr format_date( DayNumber _day, Options::DateFormat _format = Options::DateFormat::ISO8601 );
 		bool is_time_valid( const SplitTime& _time );
 		bool is_date_valid( const SplitDate& _date );
-		SplitDate today();
-		uint32_t days_between_dates( const SplitDate& _day_1, const SplitDate& _day_2 );
-		SplitDate add_days_to_date( const SplitDate& _start_day, uint32_t _nb_days );
+		DayNumber today();		// Current day of the clock, see Clock::update.
+		/**
+		* @brief Check the day of a session read from a file or typed in. Days before 1970 or after tomorrow are typos, a year 2099 would stretch the daily totals of the stats over decades of empty days.
+		* @return The given day, or no_day if it's out of range. The session is then kept without date.
+		**/
+		DayNumber check_session_day( DayNumber _day );
 
 		std::string get_cover_data( std::string_view _cover_path );
 
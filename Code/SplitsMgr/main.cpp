@@ -10,6 +10,8 @@
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
+#include "Backtest.h"
+#include "Benchmark.h"
 #include "SplitsManagerApp.h"
 
 
@@ -27,6 +29,14 @@ int __stdcall WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmd
 	g_pFZN_Core->GreetingMessage();
 	g_pFZN_Core->SetConsolePosition( sf::Vector2i( 10, 10 ) );
 
+	//Headless comparison of the end date predictions on finished lists, no window is created
+	if( SplitsMgr::Backtest::is_requested( lpCmdLine ) )
+		return SplitsMgr::Backtest::run( lpCmdLine );
+
+	//Headless timings of the hot paths on generated data
+	if( SplitsMgr::Benchmark::is_requested( lpCmdLine ) )
+		return SplitsMgr::Benchmark::run( lpCmdLine );
+
 	//Loading of the resources that don't belong in a resource group and filling of the map containing the paths to the resources)
 	g_pFZN_DataMgr->LoadResourceFile( DATAPATH( "XMLFiles/Resources" ) );
 